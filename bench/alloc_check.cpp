@@ -0,0 +1,168 @@
+/*******************************************************************************
+ * @file alloc_check.cpp
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-10
+ * @version 1.0.0
+ * @changelog
+ * - v1.0.0: Initial implementation
+ * @brief Allocation check of the streaming paths
+ *
+ * @details
+ * Built with the allocation tracking objects by 'make alloc-check'. It first
+ * checks that the tracker sees plain, array and over-aligned allocations,
+ * then runs every steady state operation of WAZUH::Benchmark record by
+ * record over the corpus read from stdin, once plain and once with the
+ * CRC32C trailer, and fails on the first record an operation allocates for.
+ */
+
+
+/******************************************************************************
+ * Cpp Includes
+ */
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "m_wazuh_alloc_tracker.h"
+#include "m_wazuh_benchmark.h"
+#include "m_wazuh_delimited_serializer.h"
+
+/******************************************************************************
+ * C includes
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+ * Constants and macros definitions
+ */
+constexpr char kCorpusDelimiter[] = ",";
+
+// Keeps the allocations of the self test from being optimized away
+static void* volatile g_sink = nullptr;
+
+/**
+ * @brief Block needing more alignment than operator new gives by default
+ */
+struct alignas (64) OverAligned {
+  char bytes[64];
+};
+
+
+/******************************************************************************
+ * Local functions
+ */
+
+/**
+ * @brief Check that the tracker counts every kind of allocation
+ */
+static bool TrackerCounts (void) {
+
+  const WAZUH::AllocationStats before = WAZUH::AllocationSnapshot ();
+
+  int* value = new int (0);
+  g_sink = value;
+  delete value;
+
+  char* array = new char[16];
+  g_sink = array;
+  delete[] array;
+
+  OverAligned* aligned = new OverAligned ();
+  g_sink = aligned;
+  const bool aligned_ok = 0 == reinterpret_cast<uintptr_t> (aligned) % alignof (OverAligned);
+  delete aligned;
+
+  const WAZUH::AllocationStats after = WAZUH::AllocationSnapshot ();
+
+  return aligned_ok &&
+         3 == after.allocations - before.allocations &&
+         3 == after.deallocations - before.deallocations &&
+         after.live_bytes == before.live_bytes;
+
+}
+
+/**
+ * @brief Check one serializer configuration, report the faults
+ */
+static bool CheckConfiguration (const char* name,
+                                const WAZUH::DelimitedSerializer& serializer,
+                                const std::vector<std::string>& records) {
+
+  WAZUH::Benchmark benchmark (serializer, 1);
+  std::vector<WAZUH::AllocationFault> faults = benchmark.CheckAllocations (records);
+
+  for (const WAZUH::AllocationFault& fault : faults) {
+
+    std::cerr << "alloc-check: '" << fault.operation << "' (" << name
+              << ") allocated " << fault.allocations << " times for record "
+              << fault.record << "." << std::endl;
+
+  }
+
+  return faults.empty ();
+
+}
+
+
+/******************************************************************************
+ * Implementation of public functions / methods
+ */
+
+/**
+ * @brief Main entry point of the check
+ */
+int main (void) {
+
+  if (!WAZUH::AllocationTrackingEnabled () || !TrackerCounts ()) {
+
+    std::cerr << "alloc-check: the allocation tracker is not counting, build with WAZUH_TRACK_ALLOCATIONS." << std::endl;
+    return 1;
+
+  }
+
+  try {
+
+    WAZUH::DelimitedSerializer plain (kCorpusDelimiter);
+    WAZUH::DelimitedSerializer checksummed (kCorpusDelimiter);
+    std::vector<std::string> records = WAZUH::Benchmark::LoadRecords (std::cin);
+    std::vector<std::string> checksummed_records;
+
+    checksummed.SetChecksum (true);
+
+    for (const std::string& record : records) {
+
+      checksummed_records.emplace_back ();
+      checksummed.SerializeRecord (plain.DeserializeLine (record),
+                                   checksummed_records.back ());
+
+    }
+
+    bool passed = CheckConfiguration ("plain", plain, records);
+    passed = CheckConfiguration ("crc32c", checksummed, checksummed_records) && passed;
+
+    if (!passed) { return 1; }
+
+    std::cout << "alloc-check: " << records.size ()
+              << " records, no steady state operation allocated." << std::endl;
+
+  } catch (const std::exception& e) {
+
+    std::cerr << "alloc-check: " << e.what () << std::endl;
+    return 1;
+
+  }
+
+  return 0;
+
+}
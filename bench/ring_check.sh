@@ -0,0 +1,81 @@
+#!/bin/sh
+#
+# Stress the shared memory ring with concurrent producers.
+#
+# Usage: ring_check.sh SERIALIZER PRODUCERS THREADS PUSHES
+#
+# Starts a ring-serve on a private ring, then PRODUCERS ring-push processes
+# at once, each pushing its own record PUSHES times from THREADS threads,
+# so the ring wraps many times over and producers race for the same slots.
+# Fails unless the server wrote every record exactly as many times as it
+# was pushed, and nothing else.
+
+serializer=$1
+producers=$2
+threads=$3
+pushes=$4
+
+ring=/wazuh-ring-check-$$
+work=$(mktemp -d)
+trap 'kill "$server" 2>/dev/null; rm -rf "$work"' EXIT
+
+"$serializer" -m ring-serve -r "$ring" > "$work/out" 2> "$work/report" &
+server=$!
+
+# The ring exists once a first record can be pushed
+tries=0
+
+until printf 'ready\n' | "$serializer" -m ring-push -r "$ring" 2>/dev/null; do
+
+  tries=$((tries + 1))
+  [ "$tries" -lt 50 ] || { echo "ring-check: ring $ring never came up"; exit 1; }
+  sleep 0.1
+
+done
+
+producer=1
+pids=
+
+while [ "$producer" -le "$producers" ]; do
+
+  printf 'producer-%s\nevent\n' "$producer" |
+    "$serializer" -m ring-push -r "$ring" -j "$threads" -i "$pushes" &
+  pids="$pids $!"
+  producer=$((producer + 1))
+
+done
+
+wait_failed=0
+
+for pid in $pids; do
+
+  wait "$pid" || wait_failed=1
+
+done
+
+kill -TERM "$server"
+wait "$server"
+cat "$work/report"
+
+[ "$wait_failed" -eq 0 ] || { echo "ring-check: a producer failed"; exit 1; }
+
+sort "$work/out" | uniq -c | awk -v producers="$producers" \
+  -v expected=$((threads * pushes)) '
+  $2 == "ready" && $1 == 1 { ++ready; next }
+  $2 ~ /^producer-[0-9]+,event$/ {
+    if ($1 != expected) {
+      printf "ring-check: %s pushed %d times, served %d\n", $2, expected, $1
+      failed = 1
+    }
+    ++seen
+    next
+  }
+  { printf "ring-check: unexpected line %s\n", $0; failed = 1 }
+  END {
+    if (1 != ready || seen != producers) {
+      printf "ring-check: %d of %d producers served\n", seen, producers
+      failed = 1
+    }
+    if (!failed) { printf "ring-check: %d records served\n", producers * expected + 1 }
+    exit failed
+  }'
@@ -0,0 +1,122 @@
+#!/bin/sh
+#
+# Compare the bench throughput of optimized builds against a baseline build.
+#
+# Usage: speedup.sh CORPUS ITERATIONS BASELINE VARIANT...
+#
+# Every binary runs '-m bench' over CORPUS, RUNS times (3 by default) taking
+# turns with the others, and the best rate of every operation is kept so
+# that other load on the host does not pass for a slowdown. For each
+# operation the records per second of the baseline are printed, followed by
+# the speedup of every variant, and a last row with the geometric mean of
+# the speedups. A variant that cannot run on this machine (e.g. an
+# unsupported -march) shows n/a.
+
+corpus=$1
+iterations=$2
+baseline=$3
+shift 3
+runs=${RUNS:-3}
+
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+# Operation name and records per second of every bench row
+run_bench () {
+  "$1" -m bench -i "$iterations" < "$corpus" 2>/dev/null |
+    awk 'NR > 1 && NF == 6 { print $1, $2 }'
+}
+
+# Best rate of every operation over the runs, in the order of the bench
+best_rate () {
+  awk '!($1 in best) { order[++count] = $1 }
+       !($1 in best) || $2 > best[$1] { best[$1] = $2 }
+       END { for (i = 1; i <= count; ++i) { print order[i], best[order[i]] } }' "$1"
+}
+
+header="Operation baseline"
+
+for variant in "$@"; do
+
+  header="$header $(basename "$(dirname "$variant")")"
+
+done
+
+run=0
+
+while [ "$run" -lt "$runs" ]; do
+
+  run_bench "$baseline" >> "$work/0.runs" || exit 1
+  index=0
+
+  for variant in "$@"; do
+
+    index=$((index + 1))
+    run_bench "$variant" >> "$work/$index.runs"
+
+  done
+
+  run=$((run + 1))
+
+done
+
+index=0
+
+while [ "$index" -le "$#" ]; do
+
+  best_rate "$work/$index.runs" > "$work/$index"
+  index=$((index + 1))
+
+done
+
+index=$#
+
+printf 'Speedup over %s (%s, %s iterations)\n' "$baseline" "$corpus" "$iterations"
+
+awk -v files="$index" -v header="$header" -v dir="$work" '
+  BEGIN {
+    columns = split (header, names, " ")
+    for (c = 1; c <= columns; ++c) { printf "%-22s", names[c] }
+    printf "\n"
+
+    while ((getline line < (dir "/0")) > 0) {
+      split (line, field, " ")
+      rows[++count] = field[1]
+      base[field[1]] = field[2]
+    }
+
+    for (f = 1; f <= files; ++f) {
+      while ((getline line < (dir "/" f)) > 0) {
+        split (line, field, " ")
+        rate[f, field[1]] = field[2]
+      }
+      logs[f] = 0
+      samples[f] = 0
+    }
+
+    for (r = 1; r <= count; ++r) {
+      op = rows[r]
+      printf "%-22s%-22s", op, base[op]
+      for (f = 1; f <= files; ++f) {
+        if ((f, op) in rate && base[op] > 0) {
+          speedup = rate[f, op] / base[op]
+          logs[f] += log (speedup)
+          ++samples[f]
+          printf "%-22s", sprintf ("x%.2f", speedup)
+        } else {
+          printf "%-22s", "n/a"
+        }
+      }
+      printf "\n"
+    }
+
+    printf "%-22s%-22s", "geomean", ""
+    for (f = 1; f <= files; ++f) {
+      if (samples[f] > 0) {
+        printf "%-22s", sprintf ("x%.2f", exp (logs[f] / samples[f]))
+      } else {
+        printf "%-22s", "n/a"
+      }
+    }
+    printf "\n"
+  }'
@@ -0,0 +1,37 @@
+#!/bin/sh
+#
+# Check the keys transcode-json gives the fields of a record.
+#
+# Usage: transcode_check.sh SERIALIZER
+#
+# Every case transcodes one record with a --columns list and compares the
+# JSON line, or the error, with the expected one. Fails on any difference.
+
+serializer=$1
+failed=0
+
+# Columns, record, expected output
+check () {
+
+  output=$(printf '%s\n' "$2" | "$serializer" -m transcode-json --columns "$1" 2>&1)
+
+  if [ "$output" != "$3" ]; then
+
+    printf 'transcode-check: --columns "%s"\n  expected %s\n  got      %s\n' \
+      "$1" "$3" "$output"
+    failed=1
+
+  fi
+
+}
+
+check 'a,b'    'x,y,z'   '{"a":"x","b":"y","2":"z"}'
+check 'a,,c'   'x,y,z,w' '{"a":"x","1":"y","c":"z","3":"w"}'
+check ',,'     'x,y,z'   '{"0":"x","1":"y","2":"z"}'
+check 'a,b,c'  'x'       '{"a":"x"}'
+check 'a,a'    'x,y'     "Serializer error: Duplicate column name 'a'."
+check 'a,1'    'x,y'     "Serializer error: Column name '1' is numeric, reserved for unnamed fields."
+
+[ "$failed" -eq 0 ] && echo "transcode-check: passed"
+
+exit "$failed"
@@ -17,6 +17,8 @@
 /******************************************************************************
 * Cpp Includes
 */
+#include <istream>
+#include <stdexcept>
 #include <string>
 
 /******************************************************************************
@@ -53,6 +55,16 @@ namespace WAZUH {
 * Class / Interfaces / Structs / Enums / Typedefs / Using declarations
 */
 
+/**
+ * @brief Exception class for serializer errors
+ */
+class serializer_error : public std::runtime_error {
+  public:
+    explicit serializer_error(const std::string& message)
+      : std::runtime_error("Serializer error: " + message) {}
+};
+
+
 /**
  * @interface IWazuhSerializer
  * @brief Interface for Wazuh Serializer
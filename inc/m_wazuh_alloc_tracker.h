@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * @file m_wazuh_alloc_tracker.h
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-10
+ * @version 1.0.0
+ * @brief Header for Wazuh Allocation Tracker module
+ *
+ * @details
+ * This file contains the declarations of the heap allocation counters.
+ * When the program is built with WAZUH_TRACK_ALLOCATIONS defined, the
+ * global operator new and delete are replaced by versions that update the
+ * counters. Otherwise the counters stay at zero and cost nothing.
+ *
+ ******************************************************************************/
+
+#ifndef _M_WAZUH_ALLOC_TRACKER_H_
+#define _M_WAZUH_ALLOC_TRACKER_H_
+
+
+/******************************************************************************
+* Cpp Includes
+*/
+#include <cstdint>
+
+/******************************************************************************
+* C includes
+*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+* Namespace declaration
+*/
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+
+
+/******************************************************************************
+* Forward declarations
+*/
+
+
+/******************************************************************************
+* Class / Interfaces / Structs / Enums / Typedefs / Using declarations
+*/
+
+/**
+ * @brief Snapshot of the heap allocation counters
+ */
+struct AllocationStats {
+  uint64_t allocations;      // Calls to operator new since start
+  uint64_t deallocations;    // Calls to operator delete since start
+  uint64_t bytes;            // Bytes requested since start
+  uint64_t live_bytes;       // Bytes allocated and not yet released
+  uint64_t peak_live_bytes;  // Highest live_bytes since the last reset
+};
+
+
+/**
+ * @brief Check whether allocations are being tracked
+ * @return true if built with WAZUH_TRACK_ALLOCATIONS
+ */
+bool AllocationTrackingEnabled (void);
+
+/**
+ * @brief Read the allocation counters
+ * @return Current values, all zero when tracking is disabled
+ */
+AllocationStats AllocationSnapshot (void);
+
+/**
+ * @brief Restart the peak live heap from the current live heap
+ */
+void ResetAllocationPeak (void);
+
+
+} /* namespace WAZUH */
+
+
+#endif /* _M_WAZUH_ALLOC_TRACKER_H_ */
@@ -2,11 +2,14 @@
  * @file m_wazuh_arg_parser.h
  * @author Roberto Enrique Castro Beltran
  * @date 2025-11-02
- * @version 1.0.0
- * @brief ...
+ * @version 1.1.0
+ * @brief Header for Wazuh Argument Parser module
  *
  * @details
- * ...
+ * This file contains the declarations for the WAZUH::ArgSchema and
+ * WAZUH::ArgParser classes. The option table is built at compile time with a
+ * perfect hash of the option names, so a malformed table or an unknown option
+ * key fails the build, and parsing the command line allocates nothing.
  *
  ******************************************************************************/
 
@@ -17,10 +20,13 @@
 /******************************************************************************
 * Cpp Includes
 */
-#include <string>
-#include <iostream>
-#include <unordered_map>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 
 /******************************************************************************
 * C includes
@@ -45,6 +51,10 @@ namespace WAZUH {
 /******************************************************************************
 * Constants and macros definitions
 */
+constexpr size_t kMaxArgOptions = 32;
+constexpr size_t kArgHashSlots = 128;       // Power of two, sparse enough for a quick seed search
+constexpr uint32_t kMaxArgHashSeeds = 1024;
+constexpr uint8_t kNoArgOption = 0xFF;
 
 
 /******************************************************************************
@@ -77,21 +87,260 @@ enum class ArgRequirement { kOptional, kMandatory };
  * @brief Structure to hold argument option details
  */
 struct ArgOption {
-  std::string description;
-  std::string value;
-  ArgRequirement requirement;
-  std::string alias;
+  std::string_view name {};               // Long name, used as '--name'
+  char alias {'\0'};                      // Short name, used as '-a'. '\0' for none
+  ArgRequirement requirement {ArgRequirement::kOptional};
+  std::string_view description {};
+  std::string_view default_value {};
+};
+
+
+/**
+ * @brief Handle of an option in a schema
+ * Obtained from ArgSchema::Key, which fails the build for unknown names when
+ * the handle is declared constexpr.
+ */
+struct ArgKey {
+  size_t index;
+};
 
-  bool operator==(const ArgOption& other) const {
-    return description == other.description &&
-           value == other.value &&
-           requirement == other.requirement;
-  }
 
+/**
+ * @brief Accepted value of an enumerated option
+ */
+template <typename E>
+struct ArgChoice {
+  std::string_view value;
+  E result;
 };
 
+
+/**
+ * @brief Compile-time option table
+ *
+ * Long names are found through a perfect hash, seeded so that no two names
+ * share a slot, and aliases through a table indexed by the character. The
+ * constructor throws on empty, short or duplicate names and on duplicate
+ * aliases, which makes a constexpr schema fail to compile.
+ */
+class ArgSchema {
+
+  public:
+
+    /**
+     * @brief Constructor from an option table
+     * @param app_name Name of the application
+     * @param app_description Description of the application
+     * @param options Option table. Names and descriptions must outlive the schema
+     * @throw arg_parser_error if the table is invalid
+     */
+    template <size_t N>
+    constexpr ArgSchema (std::string_view app_name,
+                         std::string_view app_description,
+                         const ArgOption (&options)[N]) :
+      _app_name {app_name},
+      _app_description {app_description},
+      _options {},
+      _count {N},
+      _seed {0},
+      _slots {},
+      _aliases {} {
+
+      static_assert (N <= kMaxArgOptions, "Too many options for ArgSchema");
+
+      for (size_t i = 0; i < N; ++i) {
+
+        if (options[i].name.length () < 2) {
+          throw arg_parser_error ("Option names need at least two characters.");
+        }
+
+        for (size_t j = 0; j < i; ++j) {
+
+          if (options[i].name == options[j].name) {
+            throw arg_parser_error ("Duplicate option name.");
+          }
+
+          if ('\0' != options[i].alias && options[i].alias == options[j].alias) {
+            throw arg_parser_error ("Duplicate option alias.");
+          }
+
+        }
+
+        if (static_cast<unsigned char> (options[i].alias) >= _aliases.size ()) {
+          throw arg_parser_error ("Option aliases must be ASCII.");
+        }
+
+        _options[i] = options[i];
+
+      }
+
+      this->BuildAliases ();
+      this->BuildSlots ();
+
+    }
+
+    /**
+     * @brief Get the handle of an option
+     * @param name Long name of the option
+     * @return Option handle
+     * @throw arg_parser_error if there is no such option
+     */
+    constexpr ArgKey Key (std::string_view name) const {
+
+      size_t index = this->Find (name);
+
+      if (kNoArgOption == index) {
+        throw arg_parser_error ("Unknown option.");
+      }
+
+      return ArgKey {index};
+
+    }
+
+    /**
+     * @brief Find an option by long name, or by alias for one character
+     * @param name Name without the '-' or '--' prefix
+     * @return Option index, kNoArgOption if not found
+     */
+    constexpr size_t Find (std::string_view name) const {
+
+      size_t index = kNoArgOption;
+
+      if (1 == name.length ()) {
+
+        unsigned char alias = static_cast<unsigned char> (name[0]);
+
+        if (alias < _aliases.size ()) {
+          index = _aliases[alias];
+        }
+
+      } else if (!name.empty ()) {
+
+        index = _slots[Hash (name, _seed) & (kArgHashSlots - 1)];
+
+        if (kNoArgOption != index && _options[index].name != name) {
+          index = kNoArgOption;
+        }
+
+      }
+
+      return index;
+
+    }
+
+    /**
+     * @brief Get the number of options
+     * @return Option count
+     */
+    constexpr size_t Count (void) const { return _count; }
+
+    /**
+     * @brief Get an option
+     * @param index Option index, below Count
+     * @return Option details
+     */
+    constexpr const ArgOption& Option (size_t index) const { return _options[index]; }
+
+    /**
+     * @brief Get the name of the application
+     */
+    constexpr std::string_view AppName (void) const { return _app_name; }
+
+    /**
+     * @brief Get the description of the application
+     */
+    constexpr std::string_view AppDescription (void) const { return _app_description; }
+
+  private:
+
+    /**
+     * @brief Seeded FNV-1a hash of an option name
+     */
+    static constexpr uint32_t Hash (std::string_view name, uint32_t seed) {
+
+      uint32_t hash = 2166136261u ^ seed;
+
+      for (char c : name) {
+        hash = (hash ^ static_cast<unsigned char> (c)) * 16777619u;
+      }
+
+      return hash;
+
+    }
+
+    /**
+     * @brief Fill the alias table
+     */
+    constexpr void BuildAliases (void) {
+
+      for (uint8_t& slot : _aliases) {
+        slot = kNoArgOption;
+      }
+
+      for (size_t i = 0; i < _count; ++i) {
+
+        if ('\0' != _options[i].alias) {
+          _aliases[static_cast<unsigned char> (_options[i].alias)] =
+            static_cast<uint8_t> (i);
+        }
+
+      }
+
+    }
+
+    /**
+     * @brief Search a seed with no slot collisions and fill the name table
+     * @throw arg_parser_error if no seed is found
+     */
+    constexpr void BuildSlots (void) {
+
+      for (uint32_t seed = 0; seed < kMaxArgHashSeeds; ++seed) {
+
+        bool collision = false;
+
+        for (uint8_t& slot : _slots) {
+          slot = kNoArgOption;
+        }
+
+        for (size_t i = 0; i < _count && !collision; ++i) {
+
+          uint8_t& slot = _slots[Hash (_options[i].name, seed) & (kArgHashSlots - 1)];
+
+          collision = kNoArgOption != slot;
+          slot = static_cast<uint8_t> (i);
+
+        }
+
+        if (!collision) {
+          _seed = seed;
+          return;
+        }
+
+      }
+
+      throw arg_parser_error ("No perfect hash seed for the option names.");
+
+    }
+
+  private:
+
+    // Internal data members
+    std::string_view _app_name;
+    std::string_view _app_description;
+    std::array<ArgOption, kMaxArgOptions> _options;
+    size_t _count;
+    uint32_t _seed;
+    std::array<uint8_t, kArgHashSlots> _slots;
+    std::array<uint8_t, 128> _aliases;
+
+};
+
+
 /**
  * @brief Argument parser by Wazuh
+ *
+ * Values are views of argv, or of the schema defaults, so Parse allocates
+ * nothing and argv must outlive the parser.
  */
 class ArgParser {
 
@@ -99,78 +348,105 @@ class ArgParser {
 
     /**
      * @brief Constructor of the ArgParser library
-     * @param app_name Name of the application
-     * @param app_description Description of the application
+     * @param schema Option table. Must outlive the parser
      */
-    explicit ArgParser (std::string app_name, std::string app_description);
+    explicit ArgParser (const ArgSchema& schema);
 
     /**
      * @brief Parse the command line arguments
      * @param argc Argument count
      * @param argv Argument vector
+     * @throw arg_parser_error on help, unknown, repeated or missing options
      */
     void Parse (int argc, char* argv[]);
 
     /**
-     * @brief Add an option to the parser
-     * @param option The option string (e.g., "-h or --help")
-     * @param requirement Whether the option is mandatory or optional
-     * @param description Description of the option
+     * @brief Get the value of an option
+     * @param key The option handle
+     * @return The value given in the command line, or the default
+     */
+    std::string_view operator[] (ArgKey key) const;
+
+    /**
+     * @brief Get the value of an unsigned decimal option
+     * @param key The option handle
+     * @param fallback Returned when the option has no value
+     * @param minimum Smallest accepted value
+     * @return The integer
+     * @throw arg_parser_error if the value is not a number or is too small
      */
-    void AddOption (std::string option,
-                    std::string alias = "",
-                    ArgRequirement requirement = ArgRequirement::kOptional,
-                    std::string description = "",
-                    std::string default_value = "");
+    size_t GetInteger (ArgKey key, size_t fallback, size_t minimum = 0) const;
 
     /**
-     * @brief Get the value of an option
-     * @param option The option string
-     * @return The value associated with the option
+     * @brief Get the value of a path option
+     * @param key The option handle
+     * @return The path, empty when the option has no value
      */
-    std::string operator[](const std::string& option) const;
+    std::filesystem::path GetPath (ArgKey key) const;
+
+    /**
+     * @brief Get the value of an enumerated option
+     * @param key The option handle
+     * @param choices Accepted values and their results
+     * @return The result of the matching choice
+     * @throw arg_parser_error if no choice matches
+     */
+    template <typename E, size_t M>
+    E GetEnum (ArgKey key, const ArgChoice<E> (&choices)[M]) const {
+
+      std::string_view value = (*this)[key];
+
+      for (const ArgChoice<E>& choice : choices) {
+
+        if (choice.value == value) {
+          return choice.result;
+        }
+
+      }
+
+      this->ThrowInvalidValue (key);
+
+    }
 
   private:
 
     /**
      * @brief Show header information
      */
-    inline void ShowHeader (void) const;
+    void ShowHeader (void) const;
 
     /**
      * @brief Show help information. Whow to use the application and its options
      */
-    inline void ShowHelp (void) const;
+    void ShowHelp (void) const;
 
     /**
-     * @brief Validate the provided arguments against the defined options
+     * @brief Determine if help information should be shown
      * @param argc Argument count
      * @param argv Argument vector
-     * @return true if arguments are valid, false otherwise
+     * @return true if help option is present, false otherwise
      */
-    inline bool AreValidArguments (int argc, char* argv[]) const;
+    bool ShouldShowHelp (int argc, char* argv[]) const;
 
     /**
-     * @brief Determine if help information should be shown
-     * @param argc Argument count
-     * @param argv Argument vector
-     * @return true if help option is present, false otherwise
+     * @brief Report a value that does not fit the option type
+     * @param key The option handle
+     * @throw arg_parser_error always
      */
-    inline bool ShouldShowHelp (int argc, char* argv[]) const;
+    [[noreturn]] void ThrowInvalidValue (ArgKey key) const;
 
     /**
      * @brief Get the operation removing '--' or '-' prefixes
      * @param s The input string
-     * @return The operation string
+     * @return The operation string, empty if s is not an option
      */
-    inline std::string GetOption (const std::string& s) const;
+    static std::string_view GetOption (std::string_view s);
 
   private:
 
     // Internal data members
-    std::string _app_name;
-    std::string _app_description;
-    std::unordered_map<std::string, ArgOption> _options;
+    const ArgSchema& _schema;
+    std::array<std::string_view, kMaxArgOptions> _values;
 
 };
 
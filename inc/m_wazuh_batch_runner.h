@@ -0,0 +1,224 @@
+/*******************************************************************************
+ * @file m_wazuh_batch_runner.h
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-04
+ * @version 1.0.0
+ * @brief Header for Wazuh Batch Runner module
+ *
+ * @details
+ * This file contains the declarations for the WAZUH::BatchRunner class.
+ * It serializes or deserializes many files in parallel, splitting large
+ * files into record aligned chunks that are spread over a work stealing
+ * thread pool.
+ *
+ ******************************************************************************/
+
+#ifndef _M_WAZUH_BATCH_RUNNER_H_
+#define _M_WAZUH_BATCH_RUNNER_H_
+
+
+/******************************************************************************
+* Cpp Includes
+*/
+#include "m_wazuh_delimited_serializer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/******************************************************************************
+* C includes
+*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+* Namespace declaration
+*/
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+constexpr size_t kDefaultBatchChunkSize = 1 << 20;
+constexpr size_t kBatchFilesPerThread = 2;    // Files loaded at once, per worker
+
+
+/******************************************************************************
+* Forward declarations
+*/
+class WorkStealingPool;
+
+
+/******************************************************************************
+* Class / Interfaces / Structs / Enums / Typedefs / Using declarations
+*/
+
+/**
+ * @brief Exception class for batch processing errors
+ */
+class batch_error : public std::runtime_error {
+  public:
+    explicit batch_error(const std::string& message)
+      : std::runtime_error("Batch error: " + message) {}
+};
+
+
+/**
+ * @brief Operation applied to every file of a batch
+ */
+enum class BatchMode { kSerialize, kDeserialize };
+
+
+/**
+ * @brief Aggregate figures of a batch run
+ */
+struct BatchReport {
+  size_t files = 0;
+  size_t chunks = 0;
+  uint64_t input_bytes = 0;
+  uint64_t output_bytes = 0;
+  double seconds = 0.0;
+};
+
+
+/**
+ * @brief Runs a serializer over many files in parallel
+ *
+ * Each input file produces one output file with the same name in the
+ * output directory. Its content is byte for byte the same as running the
+ * single file tool on it, regardless of the number of threads.
+ *
+ * Only kBatchFilesPerThread files per worker are loaded at a time, a new
+ * one is scheduled as soon as another is written, so memory is bound by
+ * the largest files rather than by the size of the batch.
+ */
+class BatchRunner {
+
+  public:
+
+    /**
+     * @brief Constructor with serializer and parallelism settings
+     * @param serializer Serializer applied to every file
+     * @param thread_count Number of worker threads
+     * @param chunk_size Approximate size of the pieces a file is split into
+     */
+    explicit BatchRunner (const DelimitedSerializer& serializer,
+                          size_t thread_count,
+                          size_t chunk_size = kDefaultBatchChunkSize);
+
+    /**
+     * @brief Process a list of files
+     * @param mode Serialize or deserialize
+     * @param inputs Paths of the input files
+     * @param output_dir Directory where the output files are written
+     * @return Aggregate figures of the run
+     * @throw batch_error if two inputs share a file name, or an output
+     *        would overwrite an input
+     */
+    BatchReport Run (BatchMode mode,
+                     const std::vector<std::string>& inputs,
+                     const std::string& output_dir) const;
+
+    /**
+     * @brief Expand a batch specification into a list of files
+     * @param spec A directory, or a comma separated list of files
+     * @return Input file paths, sorted when taken from a directory
+     */
+    static std::vector<std::string> ListInputs (const std::string& spec);
+
+  private:
+
+    struct FileJob;
+    struct FileWindow;
+
+    /**
+     * @brief Load a file, split it and queue its chunks
+     * @param pool Pool where the chunk tasks are submitted
+     * @param job File being processed
+     */
+    void ScheduleFile (WorkStealingPool& pool,
+                       const std::shared_ptr<FileJob>& job) const;
+
+    /**
+     * @brief Load a file and split it into chunks
+     * @param job File being processed
+     * @throw batch_error if the file cannot be read
+     */
+    void SplitFile (FileJob& job) const;
+
+    /**
+     * @brief Find the delimiter ending a deserialization chunk
+     * @param line Serialized line
+     * @param start Start of the chunk, at a field boundary
+     * @return First unescaped delimiter at least a chunk size after start,
+     *         or std::string_view::npos
+     */
+    size_t FindSplit (std::string_view line, size_t start) const;
+
+    /**
+     * @brief Process one chunk and write the file once all are done
+     * @param job File being processed
+     * @param index Index of the chunk
+     */
+    void ProcessChunk (const std::shared_ptr<FileJob>& job,
+                       size_t index) const;
+
+    /**
+     * @brief Write the output of a file, unless it failed, and let the
+     *        next file be scheduled
+     * @param job File being processed
+     */
+    void FinishFile (FileJob& job) const;
+
+    /**
+     * @brief Assemble the chunk results and write the output file
+     * @param job File being processed
+     * @throw serializer_error if a deserialized line fails its checksum
+     */
+    void WriteOutput (FileJob& job) const;
+
+    /**
+     * @brief Join the checksums of the chunks of a file
+     * @param job File whose chunks have all been processed
+     * @return CRC32C of the serialized bytes of the whole file: the
+     *         output when serializing, the input line when deserializing
+     */
+    uint32_t JoinChecksums (const FileJob& job) const;
+
+    /**
+     * @brief Check that every input has its own output, and that no output
+     *        is one of the inputs
+     * @param inputs Paths of the input files
+     * @param outputs Paths of the output files, in the same order
+     * @throw batch_error on a clash
+     */
+    static void CheckOutputs (const std::vector<std::string>& inputs,
+                              const std::vector<std::string>& outputs);
+
+  private:
+
+    const DelimitedSerializer& _serializer;
+    size_t _thread_count;
+    size_t _chunk_size;
+
+};
+
+
+} /* namespace WAZUH */
+
+
+#endif /* _M_WAZUH_BATCH_RUNNER_H_ */
@@ -0,0 +1,185 @@
+/*******************************************************************************
+ * @file m_wazuh_benchmark.h
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-10
+ * @version 1.0.0
+ * @brief Header for Wazuh Benchmark module
+ *
+ * @details
+ * This file contains the declarations for the WAZUH::Benchmark class.
+ * It times the serializer operations over a corpus of records and, in
+ * builds with allocation tracking, counts their heap allocations.
+ *
+ ******************************************************************************/
+
+#ifndef _M_WAZUH_BENCHMARK_H_
+#define _M_WAZUH_BENCHMARK_H_
+
+
+/******************************************************************************
+* Cpp Includes
+*/
+#include "m_wazuh_delimited_serializer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <string>
+#include <vector>
+
+/******************************************************************************
+* C includes
+*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+* Namespace declaration
+*/
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+constexpr size_t kDefaultBenchIterations = 10;
+
+
+/******************************************************************************
+* Forward declarations
+*/
+
+
+/******************************************************************************
+* Class / Interfaces / Structs / Enums / Typedefs / Using declarations
+*/
+
+/**
+ * @brief Measures of one operation over the whole corpus
+ */
+struct BenchResult {
+  std::string operation;
+  bool steady_state;         // Reuses its buffers, must not allocate
+  uint64_t records;          // Records processed, all iterations
+  uint64_t bytes;            // Serialized bytes processed, all iterations
+  double seconds;
+  uint64_t allocations;      // Zero unless allocations are tracked
+  uint64_t allocated_bytes;
+  uint64_t peak_live_bytes;  // Heap held at once above the starting point
+  uint64_t result_sum;       // Sum of the results, keeps the work observable
+};
+
+/**
+ * @brief Record on which a steady state operation allocated
+ */
+struct AllocationFault {
+  std::string operation;
+  size_t record;             // Index of the record in the corpus
+  uint64_t allocations;      // Allocations made while processing it
+};
+
+
+/**
+ * @brief Benchmark of the serializer operations
+ *
+ * Every operation runs once over the corpus to warm up caches and buffers,
+ * then the given number of times while it is measured. The one-shot
+ * operations (Serialize, Deserialize) build their result from scratch; the
+ * streaming ones reuse their output buffers, so once warmed up they are
+ * expected to allocate nothing per record.
+ */
+class Benchmark {
+
+  public:
+
+    /**
+     * @brief Constructor with serializer and repetitions
+     * @param serializer Serializer under test, with the corpus delimiter
+     *        and checksum settings
+     * @param iterations Measured passes over the corpus
+     */
+    explicit Benchmark (const DelimitedSerializer& serializer,
+                        size_t iterations = kDefaultBenchIterations);
+
+    /**
+     * @brief Read a corpus
+     * @param input Serialized records, one per line
+     * @return Records, without new lines
+     */
+    static std::vector<std::string> LoadRecords (std::istream& input);
+
+    /**
+     * @brief Run every operation over a corpus
+     * @param records Serialized records
+     * @return One result per operation
+     * @throw serializer_error if the corpus is empty or not valid
+     * @throw std::system_error if the output sink cannot be opened
+     */
+    std::vector<BenchResult> Run (const std::vector<std::string>& records) const;
+
+    /**
+     * @brief Check that the steady state operations never allocate per record
+     * @param records Serialized records
+     * @return First record that allocated, for every operation that did.
+     *         Empty when none did, or when allocations are not tracked
+     * @throw serializer_error if the corpus is empty or not valid
+     * @throw std::system_error if the output sink cannot be opened
+     *
+     * After a warm up pass, every record is processed alone between two
+     * reads of the allocation counter, so a single allocation is caught.
+     */
+    std::vector<AllocationFault> CheckAllocations (
+      const std::vector<std::string>& records) const;
+
+  private:
+
+    // Called with each record index, returns the size of its result
+    using Operation = std::function<size_t (size_t)>;
+    using OperationVisitor =
+      std::function<void (const std::string&, bool, const Operation&)>;
+
+    /**
+     * @brief Prepare the inputs and hand every operation to a visitor
+     * @param records Serialized records
+     * @param visit Called with the name of each operation, whether it
+     *        reuses its buffers, and the operation
+     * @throw serializer_error if the corpus is empty or not valid
+     * @throw std::system_error if the output sink cannot be opened
+     */
+    void ForEachOperation (const std::vector<std::string>& records,
+                           const OperationVisitor& visit) const;
+
+    /**
+     * @brief Warm up and measure one operation
+     * @param operation Name of the operation
+     * @param steady_state Whether the operation reuses its buffers
+     * @param records Serialized records, to count the bytes
+     * @param run Operation, called with each record index. Returns the
+     *        size of its result
+     * @return Measures of the operation
+     */
+    BenchResult Measure (const std::string& operation, bool steady_state,
+                         const std::vector<std::string>& records,
+                         const Operation& run) const;
+
+  private:
+
+    const DelimitedSerializer& _serializer;
+    size_t _iterations;
+
+};
+
+
+} /* namespace WAZUH */
+
+
+#endif /* _M_WAZUH_BENCHMARK_H_ */
@@ -0,0 +1,164 @@
+/*******************************************************************************
+ * @file m_wazuh_columnar_reader.h
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-06
+ * @version 1.0.0
+ * @brief Header for Wazuh Columnar Reader module
+ *
+ * @details
+ * This file contains the declarations for the WAZUH::ColumnarReader class
+ * and the layout of the columnar batch format written by
+ * WAZUH::ColumnarSerializer.
+ *
+ ******************************************************************************/
+
+#ifndef _M_WAZUH_COLUMNAR_READER_H_
+#define _M_WAZUH_COLUMNAR_READER_H_
+
+
+/******************************************************************************
+* Cpp Includes
+*/
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/******************************************************************************
+* C includes
+*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+* Namespace declaration
+*/
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+
+/*
+ * Columnar batch layout. Integers are little endian.
+ *
+ *   char     magic[4]                 "WZC1"
+ *   uint32   record_count             N
+ *   uint32   column_count             C
+ *   uint32   field_counts[N]          fields of every record
+ *   uint64   column_offsets[C + 1]    start of every column block, relative
+ *                                     to the end of this array
+ *   column block, C times:
+ *     uint32 value_offsets[N + 1]     start of every value in the bytes
+ *     char   bytes[]                  escaped values of the column,
+ *                                     concatenated
+ *
+ * A record with fewer fields than C has an empty value in the remaining
+ * columns; field_counts tells it apart from an empty field.
+ */
+constexpr char kColumnarMagic[] = "WZC1";
+constexpr size_t kColumnarMagicLength = sizeof (kColumnarMagic) - 1;
+
+
+/******************************************************************************
+* Forward declarations
+*/
+
+
+/******************************************************************************
+* Class / Interfaces / Structs / Enums / Typedefs / Using declarations
+*/
+
+/**
+ * @brief Random access reader over a columnar batch
+ *
+ * The reader does not copy the batch. Reading one column only touches the
+ * header and the block of that column.
+ */
+class ColumnarReader {
+
+  public:
+
+    /**
+     * @brief Constructor over a serialized batch
+     * @param batch Columnar batch. Must outlive the reader
+     * @throw serializer_error if the batch is malformed
+     */
+    explicit ColumnarReader (std::string_view batch);
+
+    /**
+     * @brief Get the number of records
+     * @return Record count
+     */
+    size_t RecordCount (void) const;
+
+    /**
+     * @brief Get the number of columns
+     * @return Number of fields of the widest record
+     */
+    size_t ColumnCount (void) const;
+
+    /**
+     * @brief Get the number of fields of a record
+     * @param record Record index
+     * @return Field count
+     */
+    size_t FieldCount (size_t record) const;
+
+    /**
+     * @brief Check whether a record has a value in a column
+     * @param column Column index
+     * @param record Record index
+     * @return true if the record has that many fields
+     */
+    bool HasValue (size_t column, size_t record) const;
+
+    /**
+     * @brief Get a value
+     * @param column Column index
+     * @param record Record index
+     * @return Value escaped as in the delimited record, empty when the
+     *         record has no such field
+     */
+    std::string_view Value (size_t column, size_t record) const;
+
+  private:
+
+    /**
+     * @brief Read a little endian 32 bits integer
+     * @param offset Offset in the batch
+     * @return Value read
+     */
+    uint32_t ReadU32 (size_t offset) const;
+
+    /**
+     * @brief Read a little endian 64 bits integer
+     * @param offset Offset in the batch
+     * @return Value read
+     */
+    uint64_t ReadU64 (size_t offset) const;
+
+  private:
+
+    std::string_view _batch;
+    size_t _record_count;
+    size_t _column_count;
+    size_t _field_counts_offset;
+    size_t _column_offsets_offset;
+    size_t _data_offset;
+
+};
+
+
+} /* namespace WAZUH */
+
+
+#endif /* _M_WAZUH_COLUMNAR_READER_H_ */
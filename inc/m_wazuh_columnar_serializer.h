@@ -0,0 +1,113 @@
+/*******************************************************************************
+ * @file m_wazuh_columnar_serializer.h
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-06
+ * @version 1.0.0
+ * @brief Header for Wazuh Columnar Serializer module
+ *
+ * @details
+ * This file contains the declarations for the WAZUH::ColumnarSerializer
+ * class. It packs many delimited records into a columnar batch, where every
+ * field position is stored as a contiguous block.
+ *
+ ******************************************************************************/
+
+#ifndef _M_WAZUH_COLUMNAR_SERIALIZER_H_
+#define _M_WAZUH_COLUMNAR_SERIALIZER_H_
+
+
+/******************************************************************************
+* Cpp Includes
+*/
+#include "i_wazuh_serializer.h"
+#include "m_wazuh_delimited_serializer.h"
+
+/******************************************************************************
+* C includes
+*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+* Namespace declaration
+*/
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+
+
+/******************************************************************************
+* Forward declarations
+*/
+
+
+/******************************************************************************
+* Class / Interfaces / Structs / Enums / Typedefs / Using declarations
+*/
+
+/**
+ * @brief Columnar batch serializer
+ *
+ * The input of Serialize is a list of delimited records, one per line, as
+ * written by DelimitedSerializer. Fields are stored escaped, so Deserialize
+ * gives the records back byte for byte. The layout of the batch is described in
+ * m_wazuh_columnar_reader.h; use ColumnarReader to scan single columns.
+ */
+class ColumnarSerializer : public IWazuhSerializer {
+
+  private:
+
+    DelimitedSerializer _delimited;
+
+  public:
+
+    /**
+     * @brief Constructor with delimiter
+     * @param delimiter Delimiter of the row wise records
+     */
+    explicit ColumnarSerializer (const std::string& delimiter);
+
+    /**
+     * @brief Serialize delimited records into a columnar batch
+     * @param input Input stream, one delimited record per line
+     * @return Columnar batch
+     * @throw serializer_error if the records or columns do not fit the
+     *        32 bits counts of the batch
+     */
+    std::string Serialize (std::istream& input) const override;
+
+    /**
+     * @brief Deserialize a columnar batch into delimited records
+     * @param input Input stream holding a columnar batch
+     * @return Delimited records, one per line
+     */
+    std::string Deserialize (std::istream& input) const override;
+
+    /**
+     * @brief Extract a single column from a columnar batch
+     * @param input Input stream holding a columnar batch
+     * @param column Column index, starting at zero
+     * @return Values of the column, one per line, for the records that
+     *         have that field. Values are escaped as in the records, so a
+     *         new line in a value never reads as a second value
+     */
+    std::string DeserializeColumn (std::istream& input, size_t column) const;
+
+};
+
+
+} /* namespace WAZUH */
+
+
+#endif /* _M_WAZUH_COLUMNAR_SERIALIZER_H_ */
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * @file m_wazuh_crc32c.h
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-07
+ * @version 1.0.0
+ * @brief Header for Wazuh CRC32C module
+ *
+ * @details
+ * This file contains the declaration of the CRC32C (Castagnoli) checksum
+ * used by the serializers to protect records. It uses the SSE4.2 crc32
+ * instruction when the CPU supports it and a table driven version otherwise.
+ *
+ ******************************************************************************/
+
+#ifndef _M_WAZUH_CRC32C_H_
+#define _M_WAZUH_CRC32C_H_
+
+
+/******************************************************************************
+* Cpp Includes
+*/
+#include <cstddef>
+#include <cstdint>
+
+/******************************************************************************
+* C includes
+*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+* Namespace declaration
+*/
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+
+
+/******************************************************************************
+* Forward declarations
+*/
+
+
+/******************************************************************************
+* Class / Interfaces / Structs / Enums / Typedefs / Using declarations
+*/
+
+/**
+ * @brief Compute or extend a CRC32C checksum
+ * @param data Bytes to checksum
+ * @param length Number of bytes
+ * @param crc Checksum of the preceding bytes, 0 to start a new one
+ * @return Checksum of the preceding bytes followed by data
+ *
+ * Checksumming a buffer in several calls gives the same result as a single
+ * call over the whole buffer.
+ */
+uint32_t Crc32c (const char* data, size_t length, uint32_t crc = 0);
+
+/**
+ * @brief Combine the checksums of two consecutive buffers
+ * @param crc1 Checksum of the first buffer
+ * @param crc2 Checksum of the second buffer, started from 0
+ * @param length2 Number of bytes of the second buffer
+ * @return Checksum of the first buffer followed by the second
+ *
+ * Lets pieces checksummed in parallel be joined without reading them again,
+ * in O(log length2) steps.
+ */
+uint32_t Crc32cCombine (uint32_t crc1, uint32_t crc2, size_t length2);
+
+
+} /* namespace WAZUH */
+
+
+#endif /* _M_WAZUH_CRC32C_H_ */
@@ -20,6 +20,14 @@
 * Cpp Includes
 */
 #include "i_wazuh_serializer.h"
+#include "m_wazuh_scatter_writer.h"
+#include "m_wazuh_utf8.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
 
 /******************************************************************************
 * C includes
@@ -49,25 +57,74 @@ namespace WAZUH {
 /******************************************************************************
 * Forward declarations
 */
+class RecordFilter;
 
 
 /******************************************************************************
 * Class / Interfaces / Structs / Enums / Typedefs / Using declarations
 */
 
+/**
+ * @brief Serializer of fields separated by a delimiter
+ *
+ * The delimiter is one or more bytes. Inside fields every occurrence of its
+ * first byte is escaped, so an unescaped first byte always starts a
+ * delimiter, even when the delimiter overlaps the bytes around it.
+ */
 class DelimitedSerializer : public IWazuhSerializer {
 
   private:
 
-    char _delimiter;
+    std::string _delimiter;
+    bool _checksum;
+    Utf8Policy _utf8_policy;
+    std::array<uint8_t, 256> _escaped_lengths;   // Escaped size of every byte
 
   public:
 
     /**
      * @brief Constructor with delimiter
-     * @param delimiter Delimiter character
+     * @param delimiter Delimiter, one or more bytes. Cannot contain '\' or
+     *        new lines, nor start with 'n', used by the new line escape
+     * @throw serializer_error if the delimiter is not valid
      */
-    explicit DelimitedSerializer (char delimiter);
+    explicit DelimitedSerializer (std::string delimiter);
+
+    /**
+     * @brief Enable or disable the CRC32C trailer of serialized records
+     * @param enabled true to write and require the trailer
+     *
+     * The trailer "\#" followed by 8 hex digits is appended to the record
+     * and covers all its bytes. Writing, the CRC is extended with each
+     * delimiter and field right after they are written, while they are
+     * still in cache; reading, with each field once the unescape scan has
+     * passed it. Cannot be used with a delimiter starting with '#'.
+     */
+    void SetChecksum (bool enabled);
+
+    /**
+     * @brief Check whether the CRC32C trailer is enabled
+     * @return true if enabled
+     */
+    bool HasChecksum (void) const;
+
+    /**
+     * @brief Set what EscapeField does with malformed UTF-8
+     * @param policy kAccept, the default, passes every byte through
+     *
+     * Validation runs over each field right before it is escaped, and costs
+     * a comparison per 16 bytes of ASCII. The '\xHH' text of kEscape reads
+     * back as literal text. Cannot be used with a delimiter starting with 'x'.
+     * @throw serializer_error if the policy is kEscape and the delimiter
+     *        starts with 'x'
+     */
+    void SetUtf8Policy (Utf8Policy policy);
+
+    /**
+     * @brief Get what EscapeField does with malformed UTF-8
+     * @return The policy
+     */
+    Utf8Policy GetUtf8Policy (void) const;
 
     /**
      * @brief Serialize input stream into a delimited string
@@ -83,9 +140,269 @@ class DelimitedSerializer : public IWazuhSerializer {
      */
     std::string Deserialize (std::istream& input) const override;
 
+    /**
+     * @brief Deserialize input stream straight into a scatter writer
+     * @param input Input stream
+     * @param output Writer receiving the fields, one per line
+     *
+     * Unescaped runs of the serialized line are emitted as spans of the
+     * input buffer, so clean fields are written without being copied.
+     */
+    void DeserializeTo (std::istream& input, ScatterWriter& output) const;
+
+    /**
+     * @brief Deserialize the records of a stream that match a filter
+     * @param input Input stream, one serialized record per line
+     * @param filter Predicates checked on the serialized records
+     * @param output Writer receiving the fields of the matching records
+     *
+     * Unlike DeserializeTo, every line of the input is a record. Records
+     * are filtered before being unescaped, and the ones that do not match
+     * cost a scan of their fields up to the last one the filter uses.
+     */
+    void DeserializeMatching (std::istream& input, const RecordFilter& filter,
+                              ScatterWriter& output) const;
+
+    /**
+     * @brief Deserialize a serialized line if it matches a filter
+     * @param line Serialized line, with its checksum trailer if enabled
+     * @param filter Predicates checked on the serialized record
+     * @param output Writer receiving the fields if the record matches. Not
+     *        flushed
+     * @return true if the record matched and was written
+     *
+     * What DeserializeMatching does for every line of its input.
+     */
+    bool DeserializeLineMatching (std::string_view line, const RecordFilter& filter,
+                                  ScatterWriter& output) const;
+
+    /**
+     * @brief Deserialize a serialized line straight into a scatter writer
+     * @param line Serialized line, with its checksum trailer if enabled
+     * @param output Writer receiving the fields. Not flushed
+     */
+    void DeserializeLineTo (std::string_view line, ScatterWriter& output) const;
+
+    /**
+     * @brief Serialize a text buffer as a complete record
+     * @param text Fields separated by new lines
+     * @param serialized String where the record, with its checksum trailer
+     *        if enabled, is appended. It is grown once to the exact size,
+     *        and reusing it avoids any allocation once its capacity fits
+     *        the records
+     */
+    void SerializeRecord (std::string_view text, std::string& serialized) const;
+
+    /**
+     * @brief Serialize a text buffer as a complete record into a caller buffer
+     * @param text Fields separated by new lines
+     * @param buffer Where the record, with its checksum trailer if enabled,
+     *        is written
+     * @param capacity Bytes available in buffer
+     * @return Bytes written, SerializedSize of the text
+     * @throw serializer_error if the record does not fit
+     */
+    size_t SerializeRecordTo (std::string_view text, char* buffer,
+                              size_t capacity) const;
+
+    /**
+     * @brief Get the exact size of the record SerializeRecord writes
+     * @param text Fields separated by new lines
+     * @return Bytes of the record, checksum trailer included
+     *
+     * A counting scan over the same byte classes as the escape kernel, so
+     * callers can size or reuse their buffers before serializing.
+     */
+    size_t SerializedSize (std::string_view text) const;
+
+    /**
+     * @brief Get the exact size of an escaped field
+     * @param field Raw field
+     * @return Bytes EscapeField appends
+     * @throw serializer_error if the field is malformed UTF-8 and the
+     *        policy is kReject
+     */
+    size_t EscapedSize (std::string_view field) const;
+
+    /**
+     * @brief Serialize a text buffer whose lines are the fields
+     * @param text Fields separated by new lines
+     * @param crc If not null, set to the CRC32C of the returned bytes,
+     *        computed while they are written
+     * @return Serialized string, without checksum trailer
+     */
+    std::string SerializeText (std::string_view text,
+                               uint32_t* crc = nullptr) const;
+
+    /**
+     * @brief Deserialize a serialized line into fields, one per line
+     * @param line Serialized line, without the trailing new line nor the
+     *        checksum trailer
+     * @param crc If not null, set to the CRC32C of the line, computed
+     *        while it is unescaped
+     * @return Deserialized string
+     */
+    std::string DeserializeLine (std::string_view line,
+                                 uint32_t* crc = nullptr) const;
+
+    /**
+     * @brief Append the checksum trailer to a serialized record
+     * @param serialized Serialized record
+     * @param crc CRC32C of the serialized record
+     */
+    void AppendChecksum (std::string& serialized, uint32_t crc) const;
+
+    /**
+     * @brief Check the checksum trailer of a whole serialized line
+     * @param line Serialized line with its trailer
+     * @return The line without its trailer
+     * @throw serializer_error if the trailer is missing or does not match
+     */
+    std::string_view VerifyChecksum (std::string_view line) const;
+
+    /**
+     * @brief Split the checksum trailer from a serialized line
+     * @param line Serialized line with its trailer
+     * @param crc Output checksum read from the trailer
+     * @return The line without its trailer
+     * @throw serializer_error if the trailer is missing
+     *
+     * For consumers that checksum the line during their own scan of it.
+     */
+    std::string_view SplitChecksum (std::string_view line, uint32_t& crc) const;
+
+    /**
+     * @brief Find the first unescaped delimiter at or after a position
+     * @param line Serialized line
+     * @param from Position where the search starts. Must be the start of a
+     *        field, or inside one: the bytes of a multi byte delimiter are
+     *        not a valid starting point
+     * @return Position of the delimiter, or std::string_view::npos
+     */
+    size_t FindDelimiter (std::string_view line, size_t from) const;
+
+    /**
+     * @brief Get the delimiter
+     * @return Delimiter bytes
+     */
+    const std::string& Delimiter (void) const;
+
+    /**
+     * @brief Escape a field and append it to a string
+     * @param field Raw field
+     * @param escaped String where the escaped field is appended
+     * @throw serializer_error if the field is malformed UTF-8 and the
+     *        policy is kReject
+     */
+    void EscapeField (std::string_view field, std::string& escaped) const;
+
+    /**
+     * @brief Escape bytes the way they appear in a serialized field
+     * @param bytes Raw bytes
+     * @param escaped String where the escaped bytes are appended
+     *
+     * Only '\', new lines and the first delimiter byte are escaped. Unlike
+     * EscapeField, no byte is dropped and the UTF-8 policy is not applied,
+     * so the result can be searched for in serialized records.
+     */
+    void EscapeLiteral (std::string_view bytes, std::string& escaped) const;
+
+    /**
+     * @brief Unescape a single serialized field and append it to a string
+     * @param field Escaped field, without delimiters
+     * @param unescaped String where the raw field is appended
+     */
+    void UnescapeField (std::string_view field, std::string& unescaped) const;
+
   private:
 
-    std::string EscapeField (const std::string& field) const;
+    /**
+     * @brief Get the size of the serialized lines of a text buffer
+     * @param text Fields separated by new lines
+     * @param valid Cleared if a field is malformed UTF-8 under a policy
+     *        other than kAccept, left untouched otherwise
+     * @return Bytes WriteFields writes
+     */
+    size_t FieldsSize (std::string_view text, bool& valid) const;
+
+    /**
+     * @brief Write the serialized lines of a text buffer
+     * @param text Fields separated by new lines
+     * @param out Where the fields are written, FieldsSize bytes
+     * @param crc If not null, extended with every field as it is written
+     * @param valid Validity FieldsSize reported, true skips UTF-8 validation
+     * @return End of the bytes written
+     */
+    char* WriteFields (std::string_view text, char* out, uint32_t* crc,
+                       bool valid) const;
+
+    /**
+     * @brief Write a complete record
+     * @param text Fields separated by new lines
+     * @param out Where the record is written, SerializedSize bytes
+     * @param valid Validity FieldsSize reported
+     * @return End of the bytes written
+     */
+    char* WriteRecord (std::string_view text, char* out, bool valid) const;
+
+    /**
+     * @brief Write the checksum trailer
+     * @param crc CRC32C of the serialized record
+     * @param out Where the trailer is written
+     * @return End of the bytes written
+     */
+    char* WriteChecksum (uint32_t crc, char* out) const;
+
+    /**
+     * @brief Get the size of an escaped field, applying the UTF-8 policy
+     * @param field Raw field
+     * @param valid Set to whether the field can be written by WriteEscaped
+     * @return Bytes the field takes escaped
+     * @throw serializer_error if the field is malformed UTF-8 and the
+     *        policy is kReject
+     */
+    size_t ScanField (std::string_view field, bool& valid) const;
+
+    /**
+     * @brief Write an escaped field, applying the UTF-8 policy
+     * @param field Raw field
+     * @param out Where the field is written, EscapedSize bytes
+     * @return End of the bytes written
+     */
+    char* WriteField (std::string_view field, char* out) const;
+
+    /**
+     * @brief Count the escaped size of bytes, without UTF-8 validation
+     * @param field Raw bytes
+     * @return Bytes WriteEscaped writes
+     */
+    size_t CountEscaped (std::string_view field) const;
+
+    /**
+     * @brief Escape bytes without UTF-8 validation
+     * @param field Raw bytes
+     * @param out Where the escaped bytes are written, CountEscaped bytes
+     * @return End of the bytes written
+     */
+    char* WriteEscaped (std::string_view field, char* out) const;
+
+    /**
+     * @brief Escape a field holding malformed UTF-8 according to the policy
+     * @param field Raw field
+     * @param out Where the field is written, or nullptr to only count
+     * @return Escaped size of the field
+     * @throw serializer_error if the policy is kReject
+     */
+    size_t EscapeInvalidUtf8 (std::string_view field, char* out) const;
+
+    /**
+     * @brief Deserialize the fields of a serialized line
+     * @param line Serialized line, without trailer
+     * @param deserialized String where the fields are appended
+     * @param crc If not null, extended with the bytes of the line
+     */
+    void DeserializeFields (std::string_view line, std::string& deserialized,
+                            uint32_t* crc) const;
 
 };
 
@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * @file m_wazuh_dictionary_serializer.h
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-05
+ * @version 1.0.0
+ * @brief Header for Wazuh Dictionary Serializer module
+ *
+ * @details
+ * This file contains the declarations for the WAZUH::DictionarySerializer
+ * class. It turns a stream of delimited records into the same records where
+ * fields repeating a recent value, from any earlier record of the stream,
+ * are replaced by a short back-reference to a dictionary slot.
+ *
+ ******************************************************************************/
+
+#ifndef _M_WAZUH_DICTIONARY_SERIALIZER_H_
+#define _M_WAZUH_DICTIONARY_SERIALIZER_H_
+
+
+/******************************************************************************
+* Cpp Includes
+*/
+#include "i_wazuh_serializer.h"
+#include "m_wazuh_delimited_serializer.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/******************************************************************************
+* C includes
+*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+* Namespace declaration
+*/
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+constexpr size_t kDefaultDictionaryCapacity = 4096;
+
+
+/******************************************************************************
+* Forward declarations
+*/
+class FieldDictionary;
+
+
+/******************************************************************************
+* Class / Interfaces / Structs / Enums / Typedefs / Using declarations
+*/
+
+/**
+ * @brief Delimited serializer with dictionary back-references
+ *
+ * The input is a stream of delimited records, one per line. A field is
+ * either copied as it is, or a reference "\*<slot>" to a value seen earlier
+ * in the stream, in the same record or a previous one. Escaped fields never
+ * start with "\*", so both forms are unambiguous. Encoder and decoder
+ * rebuild the same dictionary as they go through the records, and must use
+ * the same capacity. Every Serialize or Deserialize call is one stream,
+ * starting with an empty dictionary.
+ */
+class DictionarySerializer : public IWazuhSerializer {
+
+  private:
+
+    DelimitedSerializer _delimited;
+    size_t _capacity;
+
+  public:
+
+    /**
+     * @brief Constructor with delimiter and dictionary size
+     * @param delimiter Delimiter, as in DelimitedSerializer. Cannot start
+     *        with '*'
+     * @param capacity Number of recent values kept in the dictionary
+     * @throw serializer_error if the delimiter is not valid
+     */
+    explicit DictionarySerializer (const std::string& delimiter,
+                                   size_t capacity = kDefaultDictionaryCapacity);
+
+    /**
+     * @brief Serialize delimited records into dictionary encoded records
+     * @param input Input stream, one delimited record per line
+     * @return Encoded records, separated by new lines
+     * @throw serializer_error if a field starts with "\*"
+     */
+    std::string Serialize (std::istream& input) const override;
+
+    /**
+     * @brief Deserialize dictionary encoded records into delimited records
+     * @param input Input stream, one encoded record per line
+     * @return Delimited records, each ending with a new line
+     * @throw serializer_error on a malformed or unknown reference
+     */
+    std::string Deserialize (std::istream& input) const override;
+
+  private:
+
+    /**
+     * @brief Encode the fields of a delimited record
+     * @param line Delimited record
+     * @param dictionary Dictionary of the stream. Updated
+     * @param serialized String where the encoded record is appended
+     */
+    void EncodeRecord (std::string_view line, FieldDictionary& dictionary,
+                       std::string& serialized) const;
+
+    /**
+     * @brief Decode an encoded record back to a delimited record
+     * @param line Encoded record
+     * @param dictionary Dictionary of the stream. Updated
+     * @param deserialized String where the record and a new line are appended
+     */
+    void DecodeRecord (std::string_view line, FieldDictionary& dictionary,
+                       std::string& deserialized) const;
+
+};
+
+
+} /* namespace WAZUH */
+
+
+#endif /* _M_WAZUH_DICTIONARY_SERIALIZER_H_ */
@@ -0,0 +1,161 @@
+/*******************************************************************************
+ * @file m_wazuh_field_dictionary.h
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-05
+ * @version 1.0.0
+ * @brief Header for Wazuh Field Dictionary module
+ *
+ * @details
+ * This file contains the declarations for the WAZUH::FieldDictionary class.
+ * It keeps a bounded window of recent field values, addressed by slot, and
+ * an open addressing hash table to find the slot of a value.
+ *
+ ******************************************************************************/
+
+#ifndef _M_WAZUH_FIELD_DICTIONARY_H_
+#define _M_WAZUH_FIELD_DICTIONARY_H_
+
+
+/******************************************************************************
+* Cpp Includes
+*/
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/******************************************************************************
+* C includes
+*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+* Namespace declaration
+*/
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+
+
+/******************************************************************************
+* Forward declarations
+*/
+
+
+/******************************************************************************
+* Class / Interfaces / Structs / Enums / Typedefs / Using declarations
+*/
+
+/**
+ * @brief Bounded dictionary of recent field values
+ *
+ * Values are stored in a ring of slots: every insertion takes the next slot,
+ * evicting the oldest value. Given the same sequence of operations, an
+ * encoder and a decoder end up with identical slots, so slot numbers can be
+ * used as back-references. Only the encoder needs Find.
+ */
+class FieldDictionary {
+
+  public:
+
+    /**
+     * @brief Constructor with the number of slots
+     * @param capacity Number of values kept, at least one
+     */
+    explicit FieldDictionary (size_t capacity);
+
+    /**
+     * @brief Look up the most recent slot holding a value
+     * @param value Value to look up
+     * @param slot Output slot when found
+     * @return true if the value is in the dictionary
+     */
+    bool Find (std::string_view value, size_t& slot) const;
+
+    /**
+     * @brief Store a value in the next slot, evicting the oldest one
+     * @param value Value to store
+     * @return Slot where the value was stored
+     */
+    size_t Insert (std::string_view value);
+
+    /**
+     * @brief Move the value of an old slot to the newest position
+     * @param slot Slot to refresh
+     *
+     * Called on hits so that frequently used values are not evicted.
+     * Values already in the newer half of the ring are left untouched.
+     */
+    void Refresh (size_t slot);
+
+    /**
+     * @brief Check whether a slot holds a value
+     * @param slot Slot to check
+     * @return true if the slot has been written
+     */
+    bool IsValid (size_t slot) const;
+
+    /**
+     * @brief Get the value of a slot
+     * @param slot A valid slot
+     * @return Value stored in the slot
+     */
+    std::string_view At (size_t slot) const;
+
+    /**
+     * @brief Remove every value
+     */
+    void Clear (void);
+
+  private:
+
+    /**
+     * @brief Hash table bucket. Empty buckets have slot kEmptySlot
+     */
+    struct Bucket {
+      uint32_t hash;
+      uint32_t slot;
+    };
+
+    /**
+     * @brief Hash a value
+     * @param value Value to hash
+     * @return 32 bits hash
+     */
+    static uint32_t Hash (std::string_view value);
+
+    /**
+     * @brief Remove the table entry pointing at a slot, if any
+     * @param slot Slot being evicted
+     */
+    void Unlink (size_t slot);
+
+  private:
+
+    std::vector<std::string> _values;
+    std::vector<uint32_t> _hashes;
+    std::vector<bool> _used;
+    std::vector<Bucket> _buckets;
+    size_t _mask;
+    size_t _next;
+
+};
+
+
+} /* namespace WAZUH */
+
+
+#endif /* _M_WAZUH_FIELD_DICTIONARY_H_ */
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ * @file m_wazuh_json_transcoder.h
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-09
+ * @version 1.0.0
+ * @brief Header for Wazuh JSON Transcoder module
+ *
+ * @details
+ * This file contains the declarations for the WAZUH::JsonTranscoder class.
+ * It turns serialized delimited records into JSON lines in one pass, going
+ * straight from the delimited escapes to the JSON ones.
+ *
+ ******************************************************************************/
+
+#ifndef _M_WAZUH_JSON_TRANSCODER_H_
+#define _M_WAZUH_JSON_TRANSCODER_H_
+
+
+/******************************************************************************
+* Cpp Includes
+*/
+#include "m_wazuh_delimited_serializer.h"
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/******************************************************************************
+* C includes
+*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+* Namespace declaration
+*/
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+
+
+/******************************************************************************
+* Forward declarations
+*/
+
+
+/******************************************************************************
+* Class / Interfaces / Structs / Enums / Typedefs / Using declarations
+*/
+
+/**
+ * @brief Transcoder of delimited records into JSON lines
+ *
+ * Every record gives one line: a JSON array of strings, or an object when
+ * column names are set. Fields are never unescaped into a temporary: runs
+ * of bytes that need no escaping in JSON are found 16 at a time with SSE2
+ * and copied, and each delimited escape is replaced by its JSON escape.
+ * Bytes are copied as they are, the input is expected to be UTF-8.
+ */
+class JsonTranscoder {
+
+  public:
+
+    /**
+     * @brief Constructor with the serializer of the records
+     * @param serializer Serializer defining delimiter, escaping and checksum
+     */
+    explicit JsonTranscoder (const DelimitedSerializer& serializer);
+
+    /**
+     * @brief Set the names of the columns, to write objects
+     * @param spec Comma separated names, by field position. Empty to write
+     *        arrays. Fields without a name, past the last one or left
+     *        empty as in "a,,c", use their position as key
+     * @throw serializer_error on duplicate names, or names made of digits
+     *        only, which could collide with a position
+     */
+    void SetColumns (const std::string& spec);
+
+    /**
+     * @brief Transcode a stream of records
+     * @param input Input stream, one serialized record per line
+     * @param output Output stream, one JSON value per line
+     * @throw serializer_error if a checksum does not match. The records
+     *        before the corrupted one are written
+     */
+    void Transcode (std::istream& input, std::ostream& output) const;
+
+    /**
+     * @brief Transcode a single record
+     * @param line Serialized record, with its checksum trailer if enabled
+     * @param json String where the JSON value and a new line are appended
+     * @throw serializer_error if the checksum does not match. Nothing is
+     *        appended then
+     */
+    void TranscodeRecord (std::string_view line, std::string& json) const;
+
+  private:
+
+    /**
+     * @brief Open the JSON string of a field
+     * @param field Position of the field in the record
+     * @param json String where the key, if any, and the quote are appended
+     */
+    void OpenField (size_t field, std::string& json) const;
+
+  private:
+
+    const DelimitedSerializer& _serializer;
+
+    // Object keys, already escaped and followed by the colon and the quote
+    std::vector<std::string> _keys;
+
+};
+
+
+} /* namespace WAZUH */
+
+
+#endif /* _M_WAZUH_JSON_TRANSCODER_H_ */
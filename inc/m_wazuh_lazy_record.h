@@ -0,0 +1,166 @@
+/*******************************************************************************
+ * @file m_wazuh_lazy_record.h
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-09
+ * @version 1.0.0
+ * @brief Header for Wazuh Lazy Record module
+ *
+ * @details
+ * This file contains the declarations for the WAZUH::LazyRecord class.
+ * It gives access to the fields of a serialized record, unescaping each
+ * field only when its value is requested.
+ *
+ ******************************************************************************/
+
+#ifndef _M_WAZUH_LAZY_RECORD_H_
+#define _M_WAZUH_LAZY_RECORD_H_
+
+
+/******************************************************************************
+* Cpp Includes
+*/
+#include "m_wazuh_delimited_serializer.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/******************************************************************************
+* C includes
+*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+* Namespace declaration
+*/
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+constexpr size_t kNotUnescaped = static_cast<size_t> (-1);
+
+
+/******************************************************************************
+* Forward declarations
+*/
+
+
+/******************************************************************************
+* Class / Interfaces / Structs / Enums / Typedefs / Using declarations
+*/
+
+/**
+ * @brief Serialized record with fields unescaped on demand
+ *
+ * A single scan of the line, stopping only at backslashes and delimiters,
+ * records where every field starts and ends and whether it holds any
+ * escape sequence. Raw gives the serialized bytes of a field for free, and
+ * Value unescapes it the first time it is requested. Fields without
+ * escapes are returned as views of the line, without any copy. Reset reuses
+ * the storage of the record, so a warmed up record does not allocate.
+ */
+class LazyRecord {
+
+  public:
+
+    /**
+     * @brief Constructor over a serialized line
+     * @param serializer Serializer defining delimiter, escaping and checksum.
+     *        Must outlive the record
+     * @param line Serialized line, with its checksum trailer if enabled.
+     *        Must outlive the record
+     * @throw serializer_error if the checksum does not match
+     */
+    LazyRecord (const DelimitedSerializer& serializer, std::string_view line);
+
+    /**
+     * @brief Constructor without a line, for a record filled with Reset
+     * @param serializer Serializer defining delimiter, escaping and checksum.
+     *        Must outlive the record
+     */
+    explicit LazyRecord (const DelimitedSerializer& serializer);
+
+    /**
+     * @brief Scan another serialized line, dropping the previous one
+     * @param line Serialized line, with its checksum trailer if enabled.
+     *        Must outlive its use by the record
+     * @throw serializer_error if the checksum does not match. The record
+     *        is empty then
+     *
+     * Views returned for the previous line are no longer valid.
+     */
+    void Reset (std::string_view line);
+
+    /**
+     * @brief Get the number of fields
+     * @return Field count, at least 1 once a line is scanned
+     */
+    size_t FieldCount (void) const;
+
+    /**
+     * @brief Check whether a field holds escape sequences
+     * @param field Field index
+     * @return true if Value has to unescape the field
+     * @throw std::out_of_range if there is no such field
+     */
+    bool NeedsUnescape (size_t field) const;
+
+    /**
+     * @brief Get the serialized bytes of a field, to forward it as it is
+     * @param field Field index
+     * @return Escaped field, a view of the line
+     * @throw std::out_of_range if there is no such field
+     */
+    std::string_view Raw (size_t field) const;
+
+    /**
+     * @brief Get the value of a field, unescaping it on first access
+     * @param field Field index
+     * @return Raw value. Valid while the record and the line live
+     * @throw std::out_of_range if there is no such field
+     */
+    std::string_view Value (size_t field);
+
+  private:
+
+    /**
+     * @brief Location of a field in the line
+     */
+    struct FieldSpan {
+      size_t offset;
+      size_t length;
+      bool escaped;
+      size_t value;   // Offset in _values, or kNotUnescaped
+      size_t value_length;
+    };
+
+  private:
+
+    const DelimitedSerializer& _serializer;
+    std::string_view _line;
+    std::vector<FieldSpan> _fields;
+
+    // Unescaped values, back to back. A value is never longer than its
+    // field, so reserving the line length keeps the buffer from moving and
+    // the views already handed out stay valid
+    std::string _values;
+
+};
+
+
+} /* namespace WAZUH */
+
+
+#endif /* _M_WAZUH_LAZY_RECORD_H_ */
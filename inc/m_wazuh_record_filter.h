@@ -0,0 +1,168 @@
+/*******************************************************************************
+ * @file m_wazuh_record_filter.h
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-08
+ * @version 1.0.0
+ * @brief Header for Wazuh Record Filter module
+ *
+ * @details
+ * This file contains the declarations for the WAZUH::RecordFilter class.
+ * It evaluates field predicates directly on serialized records, so records
+ * that do not match can be skipped without being unescaped.
+ *
+ ******************************************************************************/
+
+#ifndef _M_WAZUH_RECORD_FILTER_H_
+#define _M_WAZUH_RECORD_FILTER_H_
+
+
+/******************************************************************************
+* Cpp Includes
+*/
+#include "m_wazuh_delimited_serializer.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/******************************************************************************
+* C includes
+*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+* Namespace declaration
+*/
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+
+
+/******************************************************************************
+* Forward declarations
+*/
+
+
+/******************************************************************************
+* Class / Interfaces / Structs / Enums / Typedefs / Using declarations
+*/
+
+/**
+ * @brief Exception class for filter errors
+ */
+class filter_error : public std::runtime_error {
+  public:
+    explicit filter_error(const std::string& message)
+      : std::runtime_error("Filter error: " + message) {}
+};
+
+
+/**
+ * @brief Comparison applied by a predicate
+ */
+enum class PredicateType { kEquals, kPrefix, kContains };
+
+
+/**
+ * @brief Condition on the value of one field
+ */
+struct FieldPredicate {
+  size_t field;
+  PredicateType type;
+  std::string value;
+  std::string escaped;
+};
+
+
+/**
+ * @brief Conjunction of field predicates over delimited records
+ *
+ * Literals are escaped once, when the predicate is added, and compared with
+ * the escaped bytes of the record. Fields holding escape sequences the
+ * serializer never writes are unescaped before being compared.
+ */
+class RecordFilter {
+
+  public:
+
+    /**
+     * @brief Constructor with the serializer of the records
+     * @param serializer Serializer defining delimiter and escaping
+     */
+    explicit RecordFilter (const DelimitedSerializer& serializer);
+
+    /**
+     * @brief Add predicates from their text form
+     * @param spec One or more predicates joined by "&&". Each predicate is
+     *        a field index, starting at 0, an operator and a literal:
+     *        "N=value" (equals), "N^value" (prefix) or "N~value" (contains)
+     * @throw filter_error if the text is malformed
+     */
+    void AddPredicates (const std::string& spec);
+
+    /**
+     * @brief Add a predicate
+     * @param field Field index, starting at 0
+     * @param type Comparison
+     * @param value Raw, unescaped literal
+     */
+    void AddPredicate (size_t field, PredicateType type, std::string value);
+
+    /**
+     * @brief Check whether a serialized record matches every predicate
+     * @param line Serialized record, without new line nor checksum trailer
+     * @return true if the record matches. Records without the fields the
+     *         predicates refer to never match
+     */
+    bool Matches (std::string_view line) const;
+
+    /**
+     * @brief Check whether the filter has no predicates
+     * @return true if every record matches
+     */
+    bool Empty (void) const;
+
+  private:
+
+    /**
+     * @brief Evaluate a predicate on a serialized field
+     * @param predicate Predicate to evaluate
+     * @param field Escaped field, without delimiters
+     * @return true if the field satisfies the predicate
+     */
+    bool Evaluate (const FieldPredicate& predicate,
+                   std::string_view field) const;
+
+    /**
+     * @brief Check whether a field only holds escapes the serializer writes
+     * @param field Escaped field
+     * @return true if escaped comparisons are exact for the field
+     */
+    bool IsCanonical (std::string_view field) const;
+
+  private:
+
+    const DelimitedSerializer& _serializer;
+    std::vector<FieldPredicate> _predicates;
+
+};
+
+
+} /* namespace WAZUH */
+
+
+#endif /* _M_WAZUH_RECORD_FILTER_H_ */
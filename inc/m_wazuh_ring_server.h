@@ -0,0 +1,136 @@
+/*******************************************************************************
+ * @file m_wazuh_ring_server.h
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-11
+ * @version 1.0.0
+ * @brief Header for Wazuh Ring Server module
+ *
+ * @details
+ * This file contains the declarations for the WAZUH::RingServer class.
+ * It drains a shared memory ring in batches, serializing every record and
+ * writing each batch with a single system call.
+ *
+ ******************************************************************************/
+
+#ifndef _M_WAZUH_RING_SERVER_H_
+#define _M_WAZUH_RING_SERVER_H_
+
+
+/******************************************************************************
+* Cpp Includes
+*/
+#include "m_wazuh_delimited_serializer.h"
+#include "m_wazuh_scatter_writer.h"
+#include "m_wazuh_shm_ring.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/******************************************************************************
+* C includes
+*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+* Namespace declaration
+*/
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+constexpr size_t kDefaultRingBatch = 256;
+
+
+/******************************************************************************
+* Forward declarations
+*/
+
+
+/******************************************************************************
+* Class / Interfaces / Structs / Enums / Typedefs / Using declarations
+*/
+
+/**
+ * @brief Aggregate figures of a ring server run
+ */
+struct RingReport {
+  uint64_t records = 0;
+  uint64_t rejected = 0;      // Records the serializer refused, e.g. bad UTF-8
+  uint64_t batches = 0;
+  uint64_t output_bytes = 0;
+  double seconds = 0.0;
+};
+
+
+/**
+ * @brief Consumer of a shared memory ring
+ *
+ * Every record of the ring holds the fields of an event separated by new
+ * lines, as the input of the serialize mode. Records are serialized straight
+ * from the ring, one per output line. Once its buffer has grown to fit a
+ * batch, draining allocates nothing.
+ */
+class RingServer {
+
+  public:
+
+    /**
+     * @brief Constructor with serializer, ring and output
+     * @param serializer Serializer applied to every record
+     * @param ring Ring to drain, created by this process
+     * @param fd File descriptor where the serialized records are written
+     * @param batch_records Maximum records serialized per write
+     */
+    RingServer (const DelimitedSerializer& serializer, ShmRing& ring, int fd,
+                size_t batch_records = kDefaultRingBatch);
+
+    /**
+     * @brief Serialize and write the records published so far
+     * @return Number of records drained, at most one batch
+     */
+    size_t DrainBatch (void);
+
+    /**
+     * @brief Drain the ring until asked to stop
+     * @param stop Set, e.g. from a signal handler, to end the run. The ring
+     *        is then closed and the records already pushed are drained
+     * @return Figures of the run
+     */
+    RingReport Run (const std::atomic<bool>& stop);
+
+    /**
+     * @brief Get the figures accumulated so far
+     * @return Figures, without the run time
+     */
+    const RingReport& Report (void) const;
+
+  private:
+
+    // Internal data members
+    const DelimitedSerializer& _serializer;
+    ShmRing& _ring;
+    ScatterWriter _output;
+    size_t _batch_records;
+    std::string _buffer;
+    RingReport _report;
+
+};
+
+
+} /* namespace WAZUH */
+
+
+#endif /* _M_WAZUH_RING_SERVER_H_ */
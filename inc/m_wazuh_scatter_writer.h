@@ -0,0 +1,112 @@
+/*******************************************************************************
+ * @file m_wazuh_scatter_writer.h
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-03
+ * @version 1.0.0
+ * @brief Header for Wazuh Scatter Writer module
+ *
+ * @details
+ * This file contains the declarations for the WAZUH::ScatterWriter class.
+ * It collects output spans that point into caller owned buffers and flushes
+ * them to a file descriptor with a single writev call, avoiding any copy of
+ * the bytes being written.
+ *
+ ******************************************************************************/
+
+#ifndef _M_WAZUH_SCATTER_WRITER_H_
+#define _M_WAZUH_SCATTER_WRITER_H_
+
+
+/******************************************************************************
+* Cpp Includes
+*/
+#include <cstddef>
+#include <vector>
+
+/******************************************************************************
+* C includes
+*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <sys/uio.h>
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+* Namespace declaration
+*/
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+
+
+/******************************************************************************
+* Forward declarations
+*/
+
+
+/******************************************************************************
+* Class / Interfaces / Structs / Enums / Typedefs / Using declarations
+*/
+
+/**
+ * @brief Gathers output spans and writes them with writev
+ *
+ * Appended spans are NOT copied: the memory they point to must stay valid
+ * and unmodified until the next call to Flush or Discard. Nothing is
+ * written until Flush is called.
+ */
+class ScatterWriter {
+
+  private:
+
+    int _fd;
+    std::vector<struct iovec> _spans;
+
+  public:
+
+    /**
+     * @brief Constructor with output file descriptor
+     * @param fd File descriptor where the spans are written
+     */
+    explicit ScatterWriter (int fd);
+
+    /**
+     * @brief Queue a span for output
+     * @param data Pointer to the first byte of the span
+     * @param length Number of bytes of the span
+     */
+    void Append (const char* data, size_t length);
+
+    /**
+     * @brief Write all queued spans and release them
+     */
+    void Flush (void);
+
+    /**
+     * @brief Drop queued spans without writing them
+     * @param from Number of spans to keep, all are dropped by default
+     */
+    void Discard (size_t from = 0);
+
+    /**
+     * @brief Get the number of queued spans
+     * @return Queued spans, usable as the argument of Discard
+     */
+    size_t Size (void) const;
+
+};
+
+
+} /* namespace WAZUH */
+
+
+#endif /* _M_WAZUH_SCATTER_WRITER_H_ */
@@ -0,0 +1,238 @@
+/*******************************************************************************
+ * @file m_wazuh_shm_ring.h
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-11
+ * @version 1.0.0
+ * @brief Header for Wazuh Shared Memory Ring module
+ *
+ * @details
+ * This file contains the declarations for the WAZUH::ShmRing class.
+ * It is a bounded queue of records in POSIX shared memory, written by any
+ * number of producer processes and read by a single consumer, so local
+ * agents can hand over events without a syscall or a copy through the
+ * kernel.
+ *
+ ******************************************************************************/
+
+#ifndef _M_WAZUH_SHM_RING_H_
+#define _M_WAZUH_SHM_RING_H_
+
+
+/******************************************************************************
+* Cpp Includes
+*/
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+/******************************************************************************
+* C includes
+*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+* Namespace declaration
+*/
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+constexpr uint32_t kDefaultRingSlots = 4096;
+constexpr uint32_t kDefaultRingSlotSize = 4096;
+
+
+/******************************************************************************
+* Forward declarations
+*/
+struct ShmRingHeader;
+struct ShmRingSlot;
+
+
+/******************************************************************************
+* Class / Interfaces / Structs / Enums / Typedefs / Using declarations
+*/
+
+/**
+ * @brief Exception class for shared memory transport errors
+ */
+class transport_error : public std::runtime_error {
+  public:
+    explicit transport_error(const std::string& message)
+      : std::runtime_error("Transport error: " + message) {}
+};
+
+
+/**
+ * @brief Multi producer, single consumer record ring in shared memory
+ *
+ * Every slot carries a sequence number: producers reserve a position with
+ * a compare and swap on the head, copy the record into the slot and publish
+ * it by advancing its sequence, with no lock. The consumer reads published
+ * slots in place and hands them back in batches. Sleeping sides are woken
+ * through futexes, and only when one is actually waiting, so the fast path
+ * has no syscall. A producer finding the ring full waits for the consumer.
+ *
+ * Limitation: records are drained in position order, so a producer that
+ * dies between reserving a position and publishing it blocks the ring.
+ * The consumer never gets past that slot, and once the ring fills up every
+ * other producer waits too. A slow producer cannot be told apart from a
+ * dead one, so the slot is not skipped. Recovery is to restart the
+ * consumer: creating the ring replaces the stale one.
+ */
+class ShmRing {
+
+  public:
+
+    /**
+     * @brief Constructor creating a ring, for the consumer
+     * @param name Shared memory object name, e.g. "/wazuh-ring". Replaces
+     *        any object with that name, and is removed with the ring
+     * @param slot_count Number of slots, a power of two
+     * @param slot_size Maximum record size in bytes
+     * @throw transport_error if the ring cannot be created
+     */
+    ShmRing (std::string name, uint32_t slot_count, uint32_t slot_size);
+
+    /**
+     * @brief Constructor attaching to an existing ring, for producers
+     * @param name Shared memory object name
+     * @throw transport_error if there is no ring with that name, or its
+     *        header has an invalid layout: a slot count that is not a
+     *        power of two, or slots that do not fit the object
+     */
+    explicit ShmRing (std::string name);
+
+    ShmRing (const ShmRing&) = delete;
+    ShmRing& operator= (const ShmRing&) = delete;
+
+    /**
+     * @brief Destructor, unmaps the ring and removes it if it was created
+     */
+    ~ShmRing ();
+
+    /**
+     * @brief Append a record, waiting while the ring is full
+     * @param record Record bytes
+     * @throw transport_error if the record is larger than a slot, or the
+     *        ring is closed
+     */
+    void Push (std::string_view record);
+
+    /**
+     * @brief Append a record if there is a free slot
+     * @param record Record bytes
+     * @return false if the ring is full
+     * @throw transport_error if the record is larger than a slot, or the
+     *        ring is closed
+     */
+    bool TryPush (std::string_view record);
+
+    /**
+     * @brief Consume the published records, consumer only
+     * @param consume Called with every record in order. The view points
+     *        into the ring and is only valid during the call
+     * @param max_records Maximum records consumed
+     * @return Number of records consumed
+     *
+     * The slots of the batch are handed back to the producers at once,
+     * after the last call to consume. If consume throws, the records up to
+     * the failing one are handed back before the exception is propagated.
+     */
+    size_t Drain (const std::function<void (std::string_view)>& consume,
+                  size_t max_records);
+
+    /**
+     * @brief Wait until a record is published, consumer only
+     * @param timeout Maximum wait
+     * @return true if a record is ready to be drained
+     */
+    bool WaitForRecords (std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Close the ring: pushes fail, waiting producers are woken
+     *
+     * Records already published can still be drained.
+     */
+    void Close (void);
+
+    /**
+     * @brief Check whether the ring is closed
+     * @return true if closed
+     */
+    bool IsClosed (void) const;
+
+    /**
+     * @brief Get the number of reserved records not drained yet
+     * @return Records being written or waiting for the consumer
+     */
+    size_t Pending (void) const;
+
+    /**
+     * @brief Get the maximum record size
+     * @return Slot size in bytes
+     */
+    size_t SlotSize (void) const;
+
+  private:
+
+    /**
+     * @brief Map the shared memory object
+     * @param fd Descriptor of the object
+     * @param length Bytes to map
+     * @throw transport_error if it cannot be mapped
+     */
+    void Map (int fd, size_t length);
+
+    /**
+     * @brief Get the slot of a position
+     * @param position Ring position, wraps around the slot count
+     * @return The slot
+     */
+    ShmRingSlot& Slot (uint64_t position) const;
+
+    /**
+     * @brief Reserve, fill and publish a slot
+     * @param record Record bytes
+     * @param wait Whether to wait for a free slot
+     * @return false if the ring is full and wait is false
+     */
+    bool Publish (std::string_view record, bool wait);
+
+    /**
+     * @brief Sleep until the consumer frees the slot of a position
+     * @param position Ring position the producer wants
+     */
+    void WaitForSpace (uint64_t position);
+
+  private:
+
+    // Internal data members
+    std::string _name;
+    bool _owner;
+    void* _memory;
+    size_t _length;
+    ShmRingHeader* _header;
+    char* _slots;
+
+};
+
+
+} /* namespace WAZUH */
+
+
+#endif /* _M_WAZUH_SHM_RING_H_ */
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * @file m_wazuh_simd_search.h
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-08
+ * @version 1.0.0
+ * @brief Header for Wazuh SIMD Search module
+ *
+ * @details
+ * This file contains the declaration of the vectorized substring search
+ * used to match literals against serialized records.
+ *
+ ******************************************************************************/
+
+#ifndef _M_WAZUH_SIMD_SEARCH_H_
+#define _M_WAZUH_SIMD_SEARCH_H_
+
+
+/******************************************************************************
+* Cpp Includes
+*/
+#include <cstddef>
+#include <string_view>
+
+/******************************************************************************
+* C includes
+*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+* Namespace declaration
+*/
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+
+
+/******************************************************************************
+* Forward declarations
+*/
+
+
+/******************************************************************************
+* Class / Interfaces / Structs / Enums / Typedefs / Using declarations
+*/
+
+/**
+ * @brief Find the first occurrence of a needle in a haystack
+ * @param haystack Bytes to search
+ * @param needle Bytes to look for
+ * @param from Position where the search starts
+ * @return Position of the match, or std::string_view::npos
+ *
+ * Candidate positions are found 16 at a time by comparing the first and
+ * the last byte of the needle with SSE2; only candidates are compared in
+ * full. Same result as std::string_view::find.
+ */
+size_t FindSubstring (std::string_view haystack, std::string_view needle,
+                      size_t from = 0);
+
+
+} /* namespace WAZUH */
+
+
+#endif /* _M_WAZUH_SIMD_SEARCH_H_ */
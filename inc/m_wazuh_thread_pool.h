@@ -0,0 +1,167 @@
+/*******************************************************************************
+ * @file m_wazuh_thread_pool.h
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-04
+ * @version 1.0.0
+ * @brief Header for Wazuh Thread Pool module
+ *
+ * @details
+ * This file contains the declarations for the WAZUH::WorkStealingPool class.
+ * Every worker owns a task queue; idle workers steal the oldest tasks of
+ * the others so that a burst of work submitted from one thread spreads over
+ * all the cores.
+ *
+ ******************************************************************************/
+
+#ifndef _M_WAZUH_THREAD_POOL_H_
+#define _M_WAZUH_THREAD_POOL_H_
+
+
+/******************************************************************************
+* Cpp Includes
+*/
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/******************************************************************************
+* C includes
+*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+* Namespace declaration
+*/
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+
+
+/******************************************************************************
+* Forward declarations
+*/
+
+
+/******************************************************************************
+* Class / Interfaces / Structs / Enums / Typedefs / Using declarations
+*/
+
+/**
+ * @brief Thread pool with per worker queues and work stealing
+ *
+ * Tasks submitted from a worker go to the back of its own queue and are
+ * taken LIFO by their owner, which keeps related work hot in cache. Other
+ * workers steal FIFO from the front, taking the oldest and usually largest
+ * pieces of work.
+ */
+class WorkStealingPool {
+
+  public:
+
+    using Task = std::function<void (void)>;
+
+    /**
+     * @brief Constructor with the number of workers
+     * @param thread_count Number of worker threads, at least one is used
+     */
+    explicit WorkStealingPool (size_t thread_count);
+
+    /**
+     * @brief Destructor. Waits for the workers to finish their queues
+     */
+    ~WorkStealingPool ();
+
+    WorkStealingPool (const WorkStealingPool&) = delete;
+    WorkStealingPool& operator= (const WorkStealingPool&) = delete;
+
+    /**
+     * @brief Queue a task for execution
+     * @param task Task to run. May itself submit more tasks
+     */
+    void Submit (Task task);
+
+    /**
+     * @brief Block until every submitted task has finished
+     *
+     * The first exception thrown by a task is rethrown here.
+     */
+    void Wait (void);
+
+    /**
+     * @brief Get the number of worker threads
+     * @return Worker thread count
+     */
+    size_t Size (void) const;
+
+  private:
+
+    /**
+     * @brief Task queue owned by a worker
+     */
+    struct WorkerQueue {
+      std::mutex mutex;
+      std::deque<Task> tasks;
+    };
+
+    /**
+     * @brief Worker thread main loop
+     * @param index Index of the queue owned by the worker
+     */
+    void WorkerLoop (size_t index);
+
+    /**
+     * @brief Take a task from the own queue or steal one from another
+     * @param index Index of the queue owned by the caller
+     * @param task Output task
+     * @return true if a task was taken
+     */
+    bool TakeTask (size_t index, Task& task);
+
+    /**
+     * @brief Run a task and account for its completion
+     * @param task Task to run
+     */
+    void RunTask (Task& task);
+
+  private:
+
+    std::vector<std::unique_ptr<WorkerQueue>> _queues;
+    std::vector<std::thread> _workers;
+
+    // Only taken to sleep, to wake sleepers and to record the first error
+    std::mutex _state_mutex;
+    std::condition_variable _work_available;
+    std::condition_variable _all_done;
+    std::atomic<size_t> _queued;
+    std::atomic<size_t> _pending;
+    std::atomic<size_t> _next_queue;
+    std::atomic<size_t> _sleepers;
+    bool _stopping;
+    std::exception_ptr _first_error;
+
+};
+
+
+} /* namespace WAZUH */
+
+
+#endif /* _M_WAZUH_THREAD_POOL_H_ */
@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * @file m_wazuh_utf8.h
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-10
+ * @version 1.0.0
+ * @brief Header for Wazuh UTF-8 validation module
+ *
+ * @details
+ * This file contains the UTF-8 validation used by the serializers to keep
+ * malformed text away from the indexer. Whole buffers are validated with
+ * the SSSE3 lookup table algorithm when the CPU supports it, and invalid
+ * sequences are located with a scalar decoder.
+ *
+ ******************************************************************************/
+
+#ifndef _M_WAZUH_UTF8_H_
+#define _M_WAZUH_UTF8_H_
+
+
+/******************************************************************************
+* Cpp Includes
+*/
+#include <cstddef>
+#include <string_view>
+
+/******************************************************************************
+* C includes
+*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+* Namespace declaration
+*/
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+
+
+/******************************************************************************
+* Forward declarations
+*/
+
+
+/******************************************************************************
+* Class / Interfaces / Structs / Enums / Typedefs / Using declarations
+*/
+
+/**
+ * @brief What to do with fields holding malformed UTF-8
+ */
+enum class Utf8Policy {
+  kAccept,    // Bytes are passed through unchecked
+  kReject,    // The record fails to serialize
+  kReplace,   // Every invalid sequence becomes U+FFFD
+  kEscape     // Every invalid byte becomes the text '\xHH'
+};
+
+
+/**
+ * @brief Location of a malformed sequence
+ */
+struct Utf8Error {
+  size_t position;    // Start of the sequence, std::string_view::npos if none
+  size_t length;      // Bytes in the sequence, the maximal invalid subpart
+};
+
+
+/**
+ * @brief Check whether a buffer is valid UTF-8
+ * @param text Bytes to check
+ * @return true if valid
+ *
+ * ASCII blocks of 16 bytes cost a single comparison; other blocks are
+ * checked with three nibble lookup tables (Keiser and Lemire).
+ */
+bool IsValidUtf8 (std::string_view text);
+
+/**
+ * @brief Find the first malformed sequence of a buffer
+ * @param text Bytes to check
+ * @param from Position where the search starts. Must not be inside a
+ *        multi byte sequence
+ * @return Location of the sequence, position npos if the rest is valid
+ *
+ * Overlong forms, surrogates and code points above U+10FFFF are malformed.
+ */
+Utf8Error FindInvalidUtf8 (std::string_view text, size_t from = 0);
+
+
+} /* namespace WAZUH */
+
+
+#endif /* _M_WAZUH_UTF8_H_ */
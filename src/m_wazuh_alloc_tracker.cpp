@@ -0,0 +1,327 @@
+/*******************************************************************************
+ * @file m_wazuh_alloc_tracker.cpp
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-10
+ * @version 1.0.0
+ * @changelog
+ * - v1.0.0: Initial implementation
+ * @brief Allocation Tracker implementation
+ *
+ * @details
+ * This file contains the implementation of the heap allocation counters
+ * and, with WAZUH_TRACK_ALLOCATIONS, the replacement of the global operator
+ * new and delete, aligned variants included. Every block carries a header
+ * with its size, so delete can update the live heap without help from the
+ * allocator. The header of an over-aligned block takes a whole alignment
+ * unit, which keeps the pointer returned aligned.
+ */
+
+
+/******************************************************************************
+ * Cpp Includes
+ */
+#include "m_wazuh_alloc_tracker.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+
+/******************************************************************************
+ * C includes
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+ * Namespace declaration
+ */
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+#ifdef WAZUH_TRACK_ALLOCATIONS
+
+// Keeps the returned pointer aligned as malloc would
+constexpr size_t kBlockHeaderSize = alignof (std::max_align_t);
+
+static std::atomic<uint64_t> allocations {0};
+static std::atomic<uint64_t> deallocations {0};
+static std::atomic<uint64_t> bytes {0};
+static std::atomic<uint64_t> live_bytes {0};
+static std::atomic<uint64_t> peak_live_bytes {0};
+
+
+/******************************************************************************
+ * Local functions
+ */
+
+/**
+ * @brief Get the size of the header of a block
+ */
+static size_t HeaderSize (size_t alignment) noexcept {
+
+  return alignment > kBlockHeaderSize ? alignment : kBlockHeaderSize;
+
+}
+
+/**
+ * @brief Allocate a block with its size header and count it
+ */
+static void* TrackedAllocate (size_t size,
+                              size_t alignment = kBlockHeaderSize) noexcept {
+
+  const size_t header = HeaderSize (alignment);
+  void* block = nullptr;
+
+  if (alignment <= kBlockHeaderSize) {
+
+    block = std::malloc (header + size);
+
+  } else {
+
+    // aligned_alloc wants a multiple of the alignment
+    block = std::aligned_alloc (alignment,
+                                (header + size + alignment - 1) / alignment * alignment);
+
+  }
+
+  if (nullptr == block) { return nullptr; }
+
+  *static_cast<size_t*> (block) = size;
+
+  allocations.fetch_add (1, std::memory_order_relaxed);
+  bytes.fetch_add (size, std::memory_order_relaxed);
+
+  const uint64_t live = live_bytes.fetch_add (size, std::memory_order_relaxed)
+                        + size;
+  uint64_t peak = peak_live_bytes.load (std::memory_order_relaxed);
+
+  while (live > peak &&
+         !peak_live_bytes.compare_exchange_weak (peak, live,
+                                                 std::memory_order_relaxed)) {
+  }
+
+  return static_cast<char*> (block) + header;
+
+}
+
+/**
+ * @brief Release a block allocated by TrackedAllocate and count it
+ */
+static void TrackedRelease (void* pointer,
+                            size_t alignment = kBlockHeaderSize) noexcept {
+
+  if (nullptr == pointer) { return; }
+
+  void* block = static_cast<char*> (pointer) - HeaderSize (alignment);
+
+  deallocations.fetch_add (1, std::memory_order_relaxed);
+  live_bytes.fetch_sub (*static_cast<size_t*> (block),
+                        std::memory_order_relaxed);
+
+  std::free (block);
+
+}
+
+#endif
+
+
+/******************************************************************************
+ * Implementation of public functions / methods
+ */
+
+/**
+ * @brief Check whether allocations are being tracked
+ */
+bool AllocationTrackingEnabled (void) {
+
+#ifdef WAZUH_TRACK_ALLOCATIONS
+  return true;
+#else
+  return false;
+#endif
+
+}
+
+/**
+ * @brief Read the allocation counters
+ */
+AllocationStats AllocationSnapshot (void) {
+
+  AllocationStats stats {};
+
+#ifdef WAZUH_TRACK_ALLOCATIONS
+  stats.allocations = allocations.load (std::memory_order_relaxed);
+  stats.deallocations = deallocations.load (std::memory_order_relaxed);
+  stats.bytes = bytes.load (std::memory_order_relaxed);
+  stats.live_bytes = live_bytes.load (std::memory_order_relaxed);
+  stats.peak_live_bytes = peak_live_bytes.load (std::memory_order_relaxed);
+#endif
+
+  return stats;
+
+}
+
+/**
+ * @brief Restart the peak live heap from the current live heap
+ */
+void ResetAllocationPeak (void) {
+
+#ifdef WAZUH_TRACK_ALLOCATIONS
+  peak_live_bytes.store (live_bytes.load (std::memory_order_relaxed),
+                         std::memory_order_relaxed);
+#endif
+
+}
+
+} /* namespace WAZUH */
+
+
+/******************************************************************************
+ * Replacement of the global allocation functions
+ */
+#ifdef WAZUH_TRACK_ALLOCATIONS
+
+void* operator new (size_t size) {
+
+  void* pointer = WAZUH::TrackedAllocate (size);
+  if (nullptr == pointer) { throw std::bad_alloc (); }
+
+  return pointer;
+
+}
+
+void* operator new[] (size_t size) {
+
+  return operator new (size);
+
+}
+
+void* operator new (size_t size, const std::nothrow_t&) noexcept {
+
+  return WAZUH::TrackedAllocate (size);
+
+}
+
+void* operator new[] (size_t size, const std::nothrow_t&) noexcept {
+
+  return WAZUH::TrackedAllocate (size);
+
+}
+
+void operator delete (void* pointer) noexcept {
+
+  WAZUH::TrackedRelease (pointer);
+
+}
+
+void operator delete[] (void* pointer) noexcept {
+
+  WAZUH::TrackedRelease (pointer);
+
+}
+
+void operator delete (void* pointer, size_t) noexcept {
+
+  WAZUH::TrackedRelease (pointer);
+
+}
+
+void operator delete[] (void* pointer, size_t) noexcept {
+
+  WAZUH::TrackedRelease (pointer);
+
+}
+
+void operator delete (void* pointer, const std::nothrow_t&) noexcept {
+
+  WAZUH::TrackedRelease (pointer);
+
+}
+
+void operator delete[] (void* pointer, const std::nothrow_t&) noexcept {
+
+  WAZUH::TrackedRelease (pointer);
+
+}
+
+void* operator new (size_t size, std::align_val_t alignment) {
+
+  void* pointer = WAZUH::TrackedAllocate (size, static_cast<size_t> (alignment));
+  if (nullptr == pointer) { throw std::bad_alloc (); }
+
+  return pointer;
+
+}
+
+void* operator new[] (size_t size, std::align_val_t alignment) {
+
+  return operator new (size, alignment);
+
+}
+
+void* operator new (size_t size, std::align_val_t alignment,
+                    const std::nothrow_t&) noexcept {
+
+  return WAZUH::TrackedAllocate (size, static_cast<size_t> (alignment));
+
+}
+
+void* operator new[] (size_t size, std::align_val_t alignment,
+                      const std::nothrow_t&) noexcept {
+
+  return WAZUH::TrackedAllocate (size, static_cast<size_t> (alignment));
+
+}
+
+void operator delete (void* pointer, std::align_val_t alignment) noexcept {
+
+  WAZUH::TrackedRelease (pointer, static_cast<size_t> (alignment));
+
+}
+
+void operator delete[] (void* pointer, std::align_val_t alignment) noexcept {
+
+  WAZUH::TrackedRelease (pointer, static_cast<size_t> (alignment));
+
+}
+
+void operator delete (void* pointer, size_t, std::align_val_t alignment) noexcept {
+
+  WAZUH::TrackedRelease (pointer, static_cast<size_t> (alignment));
+
+}
+
+void operator delete[] (void* pointer, size_t, std::align_val_t alignment) noexcept {
+
+  WAZUH::TrackedRelease (pointer, static_cast<size_t> (alignment));
+
+}
+
+void operator delete (void* pointer, std::align_val_t alignment,
+                      const std::nothrow_t&) noexcept {
+
+  WAZUH::TrackedRelease (pointer, static_cast<size_t> (alignment));
+
+}
+
+void operator delete[] (void* pointer, std::align_val_t alignment,
+                        const std::nothrow_t&) noexcept {
+
+  WAZUH::TrackedRelease (pointer, static_cast<size_t> (alignment));
+
+}
+
+#endif
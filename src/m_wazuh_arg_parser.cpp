@@ -2,9 +2,10 @@
  * @file m_wazuh_arg_parser.cpp
  * @author Roberto Enrique Castro Beltran
  * @date 2025-11-02
- * @version 1.0.0
+ * @version 1.1.0
  * @changelog
  * - v1.0.0: Initial implementation
+ * - v1.1.0: Compile-time option schema, allocation free parsing
  * @brief Argument parser implementation
  *
  * @details
@@ -19,6 +20,9 @@
  */
 #include "m_wazuh_arg_parser.h"
 
+#include <charconv>
+#include <iostream>
+
 
 /******************************************************************************
  * C includes
@@ -42,9 +46,8 @@ namespace WAZUH {
 /******************************************************************************
 * Constants and macros definitions
 */
-constexpr char kHelpOption[]    = "--help";
-constexpr char kHelpOption_h[]  = "-h";
-constexpr char kCommaDelimiter = ',';
+constexpr char kHelpOption[]    = "help";
+constexpr char kHelpOption_h[]  = "h";
 constexpr uint8_t kInsufficientArgsCount = 1;
 
 
@@ -55,28 +58,13 @@ constexpr uint8_t kInsufficientArgsCount = 1;
 /**
  * @brief Constructor of the ArgParser library
  */
-ArgParser::ArgParser (std::string app_name, std::string app_description) :
-  _app_name {std::move(app_name)},
-  _app_description {std::move(app_description)} {
-  // Constructor implementation
-}
-
-/**
- * @brief Add an option to the parser
- */
-void ArgParser::AddOption (std::string option,
-                           std::string alias,
-                           ArgRequirement requirement,
-                           std::string description,
-                           std::string default_value) {
-
-  ArgOption arg_option;
-  arg_option.description = std::move(description);
-  arg_option.alias = std::move(alias);
-  arg_option.value = std::move(default_value);
-  arg_option.requirement = requirement;
+ArgParser::ArgParser (const ArgSchema& schema) :
+  _schema {schema},
+  _values {} {
 
-  this->_options[option] = std::move(arg_option);
+  for (size_t i = 0; i < this->_schema.Count (); ++i) {
+    this->_values[i] = this->_schema.Option (i).default_value;
+  }
 
 }
 
@@ -85,177 +73,162 @@ void ArgParser::AddOption (std::string option,
  */
 void ArgParser::Parse (int argc, char* argv[]) {
 
-  if (this->ShouldShowHelp (argc, argv) ||
-      !this->AreValidArguments (argc, argv)) {
+  if (this->ShouldShowHelp (argc, argv)) {
 
     this->ShowHelp ();
 
     throw arg_parser_error ("Invalid or insufficient arguments provided.");
 
-  } else {
+  }
 
-    for (int i = 1; i < argc; ++i) {
+  std::array<bool, kMaxArgOptions> seen {};
 
-      std::string key = this->GetOption (argv[i]);
+  for (int i = 1; i < argc; ++i) {
 
-      for (const auto& option_pair : this->_options) {
+    size_t index = this->_schema.Find (GetOption (argv[i]));
 
-        // Check for alias match
-        if (key == option_pair.first ||
-            key == option_pair.second.alias) {
+    if (kNoArgOption == index) {
 
-          key = option_pair.first;
+      throw arg_parser_error ("Unknown argument '" + std::string (argv[i]) + "'.");
 
-          this->_options[key].value.clear();
+    }
 
-          // If the option requires a value, get the next argument
-          if (i + 1 < argc && argv[i + 1][0] != '-') {
+    const ArgOption& option = this->_schema.Option (index);
 
-            this->_options[key].value = argv[i + 1];
-            ++i;  // Skip the next argument as it's a value
+    if (seen[index]) {
 
-          }
+      throw arg_parser_error
+              ("Option '--" + std::string (option.name) + "' given more than once.");
 
-          if (this->_options[key].value.empty() &&
-              option_pair.second.requirement == ArgRequirement::kMandatory) {
+    }
 
-            this->ShowHelp ();
+    seen[index] = true;
+    this->_values[index] = std::string_view {};
 
-            throw arg_parser_error
-                    ("Mandatory option '" + key + "' requires a value.");
+    // If the option requires a value, get the next argument
+    if (i + 1 < argc && argv[i + 1][0] != '-') {
 
-          }
+      this->_values[index] = argv[i + 1];
+      ++i;  // Skip the next argument as it's a value
 
-          break;
-        }
+    }
 
-      }
+    if (this->_values[index].empty () &&
+        option.requirement == ArgRequirement::kMandatory) {
+
+      this->ShowHelp ();
+
+      throw arg_parser_error
+              ("Mandatory option '" + std::string (option.name) + "' requires a value.");
 
     }
 
   }
 
-}
+  // Check for mandatory options
+  for (size_t i = 0; i < this->_schema.Count (); ++i) {
 
-/**
- * @brief Get the value of an option
- */
-std::string ArgParser::operator[] (const std::string& option) const {
+    if (!seen[i] &&
+        ArgRequirement::kMandatory == this->_schema.Option (i).requirement) {
 
-  std::string value = "";
+      this->ShowHelp ();
 
-  auto it = this->_options.find(option);
+      throw arg_parser_error ("Invalid or insufficient arguments provided.");
 
-  if (it != this->_options.end()) {
-    value = it->second.value;
-  }
+    }
 
-  return value;
+  }
 
 }
 
-/******************************************************************************
- * Implementation of protected functions / methods
- */
-
-
-/******************************************************************************
- * Implementation of private functions / methods
- */
-
 /**
- * @brief Show header information
- * This function displays the application header information.
+ * @brief Get the value of an option
  */
-void ArgParser::ShowHeader (void) const {
+std::string_view ArgParser::operator[] (ArgKey key) const {
 
-  std::cout << std::endl << this->_app_description << std::endl << std::endl;
+  return this->_values[key.index];
 
 }
 
 /**
- * @brief Show help information. Whow to use the application and its options
+ * @brief Get the value of an unsigned decimal option
  */
-void ArgParser::ShowHelp (void) const {
-
-  this->ShowHeader ();
+size_t ArgParser::GetInteger (ArgKey key, size_t fallback, size_t minimum) const {
 
-  std::string result = "Usage:\n  " +
-                       this->_app_name +
-                       " [OPTIONS...]\n\n" +
-                       "Options:\n";
+  std::string_view value = (*this)[key];
+  size_t result = fallback;
 
-  for (const auto& option_pair : this->_options) {
+  if (!value.empty ()) {
 
-    if (!option_pair.second.alias.empty()) {
-
-      result += "-" + option_pair.second.alias + ", ";
+    auto [end, error] = std::from_chars (value.data (),
+                                         value.data () + value.length (),
+                                         result);
 
+    if (std::errc {} != error || value.data () + value.length () != end ||
+        result < minimum) {
+      this->ThrowInvalidValue (key);
     }
 
-    result += "--" + option_pair.first;
-
-    result += "       \t" + option_pair.second.description;
-
-    if (option_pair.second.requirement == ArgRequirement::kMandatory) {
-
-      result += " (Mandatory)";
-
-    } else {
-
-      result += " (Optional)";
-
-    }
-
-    std::cout << result << std::endl;
-    result.clear();
-
   }
 
-  std::cout << std::endl;
+  return result;
 
 }
 
 /**
- * @brief Validate the provided arguments against the defined options
+ * @brief Get the value of a path option
  */
-bool ArgParser::AreValidArguments (int argc, char* argv[]) const {
+std::filesystem::path ArgParser::GetPath (ArgKey key) const {
 
-  bool are_valid = true;
+  return std::filesystem::path ((*this)[key]);
 
-  // Check for mandatory options
-  for (const auto& option_pair : this->_options) {
+}
 
-    bool found = false;
+/******************************************************************************
+ * Implementation of protected functions / methods
+ */
 
-    if (ArgRequirement::kMandatory == option_pair.second.requirement) {
 
-      for (int i = 1; i < argc; ++i) {
+/******************************************************************************
+ * Implementation of private functions / methods
+ */
 
-        std::string key = this->GetOption (argv[i]);
+/**
+ * @brief Show header information
+ * This function displays the application header information.
+ */
+void ArgParser::ShowHeader (void) const {
 
-        if (key == option_pair.first ||
-            key == option_pair.second.alias) {
+  std::cout << std::endl << this->_schema.AppDescription () << std::endl << std::endl;
 
-          found = true;
-          break;
+}
 
-        }
+/**
+ * @brief Show help information. Whow to use the application and its options
+ */
+void ArgParser::ShowHelp (void) const {
 
-      }
+  this->ShowHeader ();
 
-      if (!found) {
+  std::cout << "Usage:\n  " << this->_schema.AppName ()
+            << " [OPTIONS...]\n\nOptions:\n";
 
-        are_valid = false;
-        break;
+  for (size_t i = 0; i < this->_schema.Count (); ++i) {
 
-      }
+    const ArgOption& option = this->_schema.Option (i);
 
+    if ('\0' != option.alias) {
+      std::cout << "-" << option.alias << ", ";
     }
 
+    std::cout << "--" << option.name << "       \t" << option.description
+              << (option.requirement == ArgRequirement::kMandatory
+                    ? " (Mandatory)" : " (Optional)")
+              << std::endl;
+
   }
 
-  return are_valid;
+  std::cout << std::endl;
 
 }
 
@@ -274,7 +247,7 @@ bool ArgParser::ShouldShowHelp (int argc, char* argv[]) const {
 
     for (int i = 1; i < argc; ++i) {
 
-      std::string key = this->GetOption (argv[i]);
+      std::string_view key = GetOption (argv[i]);
 
       if (kHelpOption_h == key || kHelpOption == key) {
         show_help = true;
@@ -289,12 +262,23 @@ bool ArgParser::ShouldShowHelp (int argc, char* argv[]) const {
 
 }
 
+/**
+ * @brief Report a value that does not fit the option type
+ */
+void ArgParser::ThrowInvalidValue (ArgKey key) const {
+
+  throw arg_parser_error ("Invalid value '" + std::string ((*this)[key]) +
+                          "' for option '--" +
+                          std::string (this->_schema.Option (key.index).name) + "'.");
+
+}
+
 /**
  * @brief Get the operation removing '--' or '-' prefixes
  */
-std::string ArgParser::GetOption (const std::string& s) const {
+std::string_view ArgParser::GetOption (std::string_view s) {
 
-  std::string operation;
+  std::string_view operation;
 
   if (s.rfind ("--", 0) == 0) {
     operation = s.substr(2);
@@ -0,0 +1,640 @@
+/*******************************************************************************
+ * @file m_wazuh_batch_runner.cpp
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-04
+ * @version 1.1.0
+ * @changelog
+ * - v1.0.0: Initial implementation
+ * - v1.1.0: Multi byte delimiters
+ * @brief Batch Runner implementation
+ *
+ * @details
+ * This file contains the implementation of the WAZUH::BatchRunner class.
+ * Serialization joins the lines of a file, so a file can be cut right after
+ * any new line and the escaped pieces joined again with the delimiter.
+ * Deserialization emits one line per field, so the serialized line can be
+ * cut at any unescaped delimiter and the pieces simply concatenated.
+ * Files are handed to the pool through a window, so only a few of them are
+ * held in memory at a time.
+ */
+
+
+/******************************************************************************
+ * Cpp Includes
+ */
+#include "m_wazuh_batch_runner.h"
+#include "m_wazuh_crc32c.h"
+#include "m_wazuh_thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <set>
+#include <string_view>
+#include <utility>
+
+
+/******************************************************************************
+ * C includes
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+ * Namespace declaration
+ */
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+constexpr char kInputListSeparator = ',';
+
+
+/******************************************************************************
+* Class / Interfaces / Structs / Enums / Typedefs / Using declarations
+*/
+
+/**
+ * @brief Files loaded at a time. Run waits for a free place before
+ *        scheduling the next file, FinishFile gives the place back
+ */
+struct BatchRunner::FileWindow {
+  std::mutex mutex;
+  std::condition_variable released;
+  size_t in_flight = 0;
+  bool failed = false;
+};
+
+
+/**
+ * @brief State of a file while its chunks are being processed
+ */
+struct BatchRunner::FileJob {
+  BatchMode mode;
+  std::string input_path;
+  std::string output_path;
+  std::string content;
+  std::vector<std::pair<size_t, size_t>> chunks;
+  std::vector<std::string> results;
+  std::vector<uint32_t> crcs;             // Of every chunk, when checksummed
+  uint32_t expected_crc = 0;              // Trailer of a deserialized line
+  uint64_t input_bytes = 0;
+  std::atomic<size_t> remaining {0};
+  std::atomic<bool> failed {false};
+  std::atomic<uint64_t>* output_bytes = nullptr;
+  FileWindow* window = nullptr;
+};
+
+
+/******************************************************************************
+ * Implementation of public functions / methods
+ */
+
+/**
+ * @brief Constructor with serializer and parallelism settings
+ */
+BatchRunner::BatchRunner (const DelimitedSerializer& serializer,
+                          size_t thread_count,
+                          size_t chunk_size) :
+  _serializer {serializer},
+  _thread_count {std::max<size_t> (thread_count, 1)},
+  _chunk_size {std::max<size_t> (chunk_size, 1)} {
+
+}
+
+/**
+ * @brief Process a list of files
+ */
+BatchReport BatchRunner::Run (BatchMode mode,
+                              const std::vector<std::string>& inputs,
+                              const std::string& output_dir) const {
+
+  namespace fs = std::filesystem;
+
+  BatchReport report;
+  std::atomic<uint64_t> output_bytes {0};
+  std::vector<std::shared_ptr<FileJob>> jobs;
+  std::vector<std::string> outputs;
+  FileWindow window;
+  const size_t max_in_flight = this->_thread_count * kBatchFilesPerThread;
+
+  for (const auto& input : inputs) {
+
+    outputs.push_back ((fs::path (output_dir) /
+                        fs::path (input).filename ()).string ());
+
+  }
+
+  CheckOutputs (inputs, outputs);
+
+  fs::create_directories (output_dir);
+
+  for (size_t i = 0; i < inputs.size (); ++i) {
+
+    auto job = std::make_shared<FileJob> ();
+    job->mode = mode;
+    job->input_path = inputs[i];
+    job->output_path = outputs[i];
+    job->output_bytes = &output_bytes;
+    job->window = &window;
+
+    jobs.push_back (std::move (job));
+
+  }
+
+  auto start = std::chrono::steady_clock::now ();
+
+  {
+    WorkStealingPool pool (this->_thread_count);
+
+    for (const auto& job : jobs) {
+
+      {
+        std::unique_lock<std::mutex> lock (window.mutex);
+
+        window.released.wait (lock, [&window, max_in_flight] {
+          return window.in_flight < max_in_flight || window.failed;
+        });
+
+        // Wait rethrows the error, do not load more files
+        if (window.failed) { break; }
+
+        ++window.in_flight;
+      }
+
+      pool.Submit ([this, &pool, job] { this->ScheduleFile (pool, job); });
+
+    }
+
+    pool.Wait ();
+  }
+
+  auto end = std::chrono::steady_clock::now ();
+
+  for (const auto& job : jobs) {
+
+    report.input_bytes += job->input_bytes;
+    report.chunks += job->chunks.size ();
+
+  }
+
+  report.files = jobs.size ();
+  report.output_bytes = output_bytes.load ();
+  report.seconds = std::chrono::duration<double> (end - start).count ();
+
+  return report;
+
+}
+
+/**
+ * @brief Expand a batch specification into a list of files
+ */
+std::vector<std::string> BatchRunner::ListInputs (const std::string& spec) {
+
+  namespace fs = std::filesystem;
+
+  std::vector<std::string> inputs;
+
+  if (fs::is_directory (spec)) {
+
+    for (const auto& entry : fs::directory_iterator (spec)) {
+
+      if (entry.is_regular_file ()) {
+
+        inputs.push_back (entry.path ().string ());
+
+      }
+
+    }
+
+    // Directory order is unspecified, keep runs reproducible
+    std::sort (inputs.begin (), inputs.end ());
+
+  } else {
+
+    size_t start = 0;
+
+    while (start <= spec.length ()) {
+
+      size_t end = spec.find (kInputListSeparator, start);
+      if (std::string::npos == end) { end = spec.length (); }
+
+      if (end > start) {
+
+        inputs.push_back (spec.substr (start, end - start));
+
+      }
+
+      start = end + 1;
+
+    }
+
+  }
+
+  return inputs;
+
+}
+
+
+/******************************************************************************
+ * Implementation of protected functions / methods
+ */
+
+
+/******************************************************************************
+ * Implementation of private functions / methods
+ */
+
+/**
+ * @brief Load a file, split it and queue its chunks
+ */
+void BatchRunner::ScheduleFile (WorkStealingPool& pool,
+                                const std::shared_ptr<FileJob>& job) const {
+
+  try {
+
+    this->SplitFile (*job);
+
+  } catch (...) {
+
+    job->failed = true;
+    this->FinishFile (*job);
+    throw;
+
+  }
+
+  if (job->chunks.empty ()) {
+
+    this->FinishFile (*job);
+
+  } else {
+
+    job->results.resize (job->chunks.size ());
+    job->crcs.resize (job->chunks.size ());
+    job->remaining = job->chunks.size ();
+
+    for (size_t i = 0; i < job->chunks.size (); ++i) {
+
+      pool.Submit ([this, job, i] { this->ProcessChunk (job, i); });
+
+    }
+
+  }
+
+}
+
+/**
+ * @brief Load a file and split it into chunks
+ */
+void BatchRunner::SplitFile (FileJob& job) const {
+
+  std::ifstream file (job.input_path, std::ios::binary);
+
+  if (!file) {
+
+    throw batch_error ("Cannot open input file '" + job.input_path + "'.");
+
+  }
+
+  job.content.assign ((std::istreambuf_iterator<char> (file)),
+                      std::istreambuf_iterator<char> ());
+
+  job.input_bytes = job.content.length ();
+
+  std::string_view content (job.content);
+
+  if (BatchMode::kSerialize == job.mode) {
+
+    // Chunks end right after a new line, or at the end of the file
+    size_t start = 0;
+
+    while (start < content.length ()) {
+
+      size_t end = content.length ();
+
+      if (end - start > this->_chunk_size) {
+
+        size_t new_line = content.find ('\n', start + this->_chunk_size - 1);
+        if (std::string_view::npos != new_line) { end = new_line + 1; }
+
+      }
+
+      job.chunks.emplace_back (start, end);
+      start = end;
+
+    }
+
+  } else if (!content.empty ()) {
+
+    // Only the first line is deserialized. Chunks end at an unescaped
+    // delimiter, which is consumed between them
+    std::string_view line = content.substr (0, content.find ('\n'));
+    size_t start = 0;
+
+    // The trailer covers the whole line. Every chunk checksums its piece
+    // while unescaping it, and the pieces are joined before writing
+    if (this->_serializer.HasChecksum ()) {
+
+      line = this->_serializer.SplitChecksum (line, job.expected_crc);
+
+    }
+
+    for (;;) {
+
+      size_t split = std::string_view::npos;
+
+      if (line.length () - start > this->_chunk_size) {
+
+        split = this->FindSplit (line, start);
+
+      }
+
+      if (std::string_view::npos == split) {
+
+        job.chunks.emplace_back (start, line.length ());
+        break;
+
+      }
+
+      job.chunks.emplace_back (start, split);
+      start = split + this->_serializer.Delimiter ().length ();
+
+    }
+
+  }
+
+}
+
+/**
+ * @brief Find the delimiter ending a deserialization chunk
+ */
+size_t BatchRunner::FindSplit (std::string_view line, size_t start) const {
+
+  const std::string& delimiter = this->_serializer.Delimiter ();
+  const size_t target = start + this->_chunk_size;
+
+  if (1 == delimiter.length ()) {
+
+    return this->_serializer.FindDelimiter (line, target);
+
+  }
+
+  // A multi byte delimiter can overlap itself ("||" in "a||||b"), so a
+  // search starting inside one may match across two. Walk the delimiters
+  // from the start of the chunk instead of jumping to the target
+  size_t split = this->_serializer.FindDelimiter (line, start);
+
+  while (std::string_view::npos != split && split < target) {
+
+    split = this->_serializer.FindDelimiter (line, split + delimiter.length ());
+
+  }
+
+  return split;
+
+}
+
+/**
+ * @brief Process one chunk and write the file once all are done
+ */
+void BatchRunner::ProcessChunk (const std::shared_ptr<FileJob>& job,
+                                size_t index) const {
+
+  std::string_view content (job->content);
+  const auto& chunk = job->chunks[index];
+  std::string_view piece = content.substr (chunk.first,
+                                           chunk.second - chunk.first);
+  std::exception_ptr error;
+  uint32_t* crc = this->_serializer.HasChecksum () ? &job->crcs[index] : nullptr;
+
+  try {
+
+    if (BatchMode::kSerialize == job->mode) {
+
+      job->results[index] = this->_serializer.SerializeText (piece, crc);
+
+    } else {
+
+      job->results[index] = this->_serializer.DeserializeLine (piece, crc);
+
+    }
+
+  } catch (...) {
+
+    error = std::current_exception ();
+    job->failed = true;
+
+  }
+
+  // The last chunk to finish assembles the file, even after a failure,
+  // so that its place in the window is given back
+  if (1 == job->remaining.fetch_sub (1, std::memory_order_acq_rel)) {
+
+    this->FinishFile (*job);
+
+  }
+
+  if (error) {
+
+    std::rethrow_exception (error);
+
+  }
+
+}
+
+/**
+ * @brief Write the output of a file, unless it failed, and let the next
+ *        file be scheduled
+ */
+void BatchRunner::FinishFile (FileJob& job) const {
+
+  std::exception_ptr error;
+
+  if (!job.failed) {
+
+    try {
+
+      this->WriteOutput (job);
+
+    } catch (...) {
+
+      error = std::current_exception ();
+      job.failed = true;
+
+    }
+
+  }
+
+  {
+    std::lock_guard<std::mutex> lock (job.window->mutex);
+
+    --job.window->in_flight;
+    job.window->failed = job.window->failed || job.failed;
+  }
+
+  job.window->released.notify_one ();
+
+  if (error) {
+
+    std::rethrow_exception (error);
+
+  }
+
+}
+
+/**
+ * @brief Assemble the chunk results and write the output file
+ */
+void BatchRunner::WriteOutput (FileJob& job) const {
+
+  const bool checksum = this->_serializer.HasChecksum ();
+  const uint32_t crc = checksum ? this->JoinChecksums (job) : 0;
+
+  // A corrupted line leaves no output file behind
+  if (checksum && BatchMode::kDeserialize == job.mode &&
+      !job.chunks.empty () && crc != job.expected_crc) {
+
+    throw serializer_error ("Checksum mismatch, the record is corrupted.");
+
+  }
+
+  std::ofstream file (job.output_path, std::ios::binary | std::ios::trunc);
+
+  if (!file) {
+
+    throw batch_error ("Cannot create output file '" + job.output_path + "'.");
+
+  }
+
+  uint64_t written = 0;
+  const std::string& delimiter = this->_serializer.Delimiter ();
+
+  for (size_t i = 0; i < job.results.size (); ++i) {
+
+    if (BatchMode::kSerialize == job.mode && i > 0) {
+
+      file << delimiter;
+      written += delimiter.length ();
+
+    }
+
+    file << job.results[i];
+    written += job.results[i].length ();
+
+  }
+
+  // Same trailer and new line the single file tool prints after serializing
+  if (BatchMode::kSerialize == job.mode) {
+
+    std::string trailer;
+
+    if (checksum) {
+
+      this->_serializer.AppendChecksum (trailer, crc);
+
+    }
+
+    trailer += '\n';
+    file << trailer;
+    written += trailer.length ();
+
+  }
+
+  if (!file.flush ()) {
+
+    throw batch_error ("Cannot write output file '" + job.output_path + "'.");
+
+  }
+
+  *job.output_bytes += written;
+
+  // Release the memory of the file as soon as it is written
+  std::string ().swap (job.content);
+  std::vector<std::string> ().swap (job.results);
+
+}
+
+/**
+ * @brief Join the checksums of the chunks of a file
+ */
+uint32_t BatchRunner::JoinChecksums (const FileJob& job) const {
+
+  const std::string& delimiter = this->_serializer.Delimiter ();
+  uint32_t crc = 0;
+
+  for (size_t i = 0; i < job.crcs.size (); ++i) {
+
+    // Chunks are cut around a delimiter, which belongs to none of them
+    if (i > 0) {
+
+      crc = Crc32c (delimiter.data (), delimiter.length (), crc);
+
+    }
+
+    const size_t length = BatchMode::kSerialize == job.mode
+                          ? job.results[i].length ()
+                          : job.chunks[i].second - job.chunks[i].first;
+
+    crc = Crc32cCombine (crc, job.crcs[i], length);
+
+  }
+
+  return crc;
+
+}
+
+/**
+ * @brief Check that every input has its own output, and that no output is
+ *        one of the inputs
+ */
+void BatchRunner::CheckOutputs (const std::vector<std::string>& inputs,
+                                const std::vector<std::string>& outputs) {
+
+  namespace fs = std::filesystem;
+
+  std::set<fs::path> input_paths;
+  std::set<fs::path> output_paths;
+
+  for (const auto& input : inputs) {
+
+    input_paths.insert (fs::weakly_canonical (input));
+
+  }
+
+  for (size_t i = 0; i < outputs.size (); ++i) {
+
+    fs::path output = fs::weakly_canonical (outputs[i]);
+
+    if (input_paths.count (output)) {
+
+      throw batch_error ("Output file '" + outputs[i] + "' would overwrite an input.");
+
+    }
+
+    if (!output_paths.insert (output).second) {
+
+      throw batch_error ("Input '" + inputs[i] + "' has the same file name as another input.");
+
+    }
+
+  }
+
+}
+
+} /* namespace WAZUH */
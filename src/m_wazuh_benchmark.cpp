@@ -0,0 +1,380 @@
+/*******************************************************************************
+ * @file m_wazuh_benchmark.cpp
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-10
+ * @version 1.1.0
+ * @changelog
+ * - v1.0.0: Initial implementation
+ * - v1.1.0: Shared memory ring operation
+ * @brief Benchmark implementation
+ *
+ * @details
+ * This file contains the implementation of the WAZUH::Benchmark class.
+ * Inputs are prepared before any measure, so the counters of an operation
+ * only see the allocations made by the operation itself.
+ */
+
+
+/******************************************************************************
+ * Cpp Includes
+ */
+#include "m_wazuh_benchmark.h"
+#include "m_wazuh_alloc_tracker.h"
+#include "m_wazuh_json_transcoder.h"
+#include "m_wazuh_lazy_record.h"
+#include "m_wazuh_record_filter.h"
+#include "m_wazuh_ring_server.h"
+#include "m_wazuh_scatter_writer.h"
+
+#include <cerrno>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+
+/******************************************************************************
+ * C includes
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+ * Namespace declaration
+ */
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+constexpr char kOutputSink[] = "/dev/null";
+constexpr char kBenchRingPrefix[] = "/wazuh-bench-";
+constexpr size_t kBenchRingSlots = 1024;
+
+// Field the filter operation tests, or the last one of shorter records
+constexpr size_t kBenchFilterField = 2;
+
+// Fields of a lazy record read by value, the others are forwarded raw
+constexpr size_t kBenchLazyValues = 2;
+
+
+/******************************************************************************
+ * Implementation of public functions / methods
+ */
+
+/**
+ * @brief Constructor with serializer and repetitions
+ */
+Benchmark::Benchmark (const DelimitedSerializer& serializer,
+                      size_t iterations) :
+  _serializer {serializer},
+  _iterations {iterations} {
+
+}
+
+/**
+ * @brief Read a corpus
+ */
+std::vector<std::string> Benchmark::LoadRecords (std::istream& input) {
+
+  std::vector<std::string> records;
+  std::string line;
+
+  while (std::getline (input, line)) {
+
+    records.push_back (line);
+
+  }
+
+  return records;
+
+}
+
+/**
+ * @brief Run every operation over a corpus
+ */
+std::vector<BenchResult> Benchmark::Run (
+  const std::vector<std::string>& records) const {
+
+  std::vector<BenchResult> results;
+
+  this->ForEachOperation (records,
+    [&] (const std::string& operation, bool steady_state, const Operation& run) {
+      results.push_back (this->Measure (operation, steady_state, records, run));
+    });
+
+  return results;
+
+}
+
+/**
+ * @brief Check that the steady state operations never allocate per record
+ */
+std::vector<AllocationFault> Benchmark::CheckAllocations (
+  const std::vector<std::string>& records) const {
+
+  std::vector<AllocationFault> faults;
+
+  this->ForEachOperation (records,
+    [&] (const std::string& operation, bool steady_state, const Operation& run) {
+
+      if (!steady_state) { return; }
+
+      // Buffers grow to the largest record during the warm up pass
+      for (size_t i = 0; i < records.size (); ++i) { run (i); }
+
+      for (size_t i = 0; i < records.size (); ++i) {
+
+        const uint64_t before = AllocationSnapshot ().allocations;
+        run (i);
+        const uint64_t allocations = AllocationSnapshot ().allocations - before;
+
+        if (0 != allocations) {
+
+          faults.push_back ({operation, i, allocations});
+          break;
+
+        }
+
+      }
+
+    });
+
+  return faults;
+
+}
+
+
+/******************************************************************************
+ * Implementation of protected functions / methods
+ */
+
+
+/******************************************************************************
+ * Implementation of private functions / methods
+ */
+
+/**
+ * @brief Prepare the inputs and hand every operation to a visitor
+ */
+void Benchmark::ForEachOperation (const std::vector<std::string>& records,
+                                  const OperationVisitor& visit) const {
+
+  if (records.empty ()) {
+
+    throw serializer_error ("Empty benchmark corpus.");
+
+  }
+
+  // Inputs of every operation, prepared before any measure
+  std::vector<std::string> texts;
+
+  for (const std::string& record : records) {
+
+    std::string_view payload = record;
+
+    if (this->_serializer.HasChecksum ()) {
+
+      payload = this->_serializer.VerifyChecksum (record);
+
+    }
+
+    texts.push_back (this->_serializer.DeserializeLine (payload));
+
+  }
+
+  // Keep the records sharing a field with the first record, the program in
+  // the bundled corpus, so the filter scans into the records and some match
+  RecordFilter filter (this->_serializer);
+  std::string_view filter_text = texts[0];
+  size_t filter_field = 0;
+
+  while (filter_field < kBenchFilterField &&
+         std::string_view::npos != filter_text.find ('\n')) {
+
+    filter_text.remove_prefix (filter_text.find ('\n') + 1);
+    ++filter_field;
+
+  }
+
+  filter.AddPredicate (filter_field, PredicateType::kEquals,
+                       std::string (filter_text.substr (0, filter_text.find ('\n'))));
+
+  JsonTranscoder transcoder (this->_serializer);
+  LazyRecord lazy_record (this->_serializer);
+
+  int sink = open (kOutputSink, O_WRONLY);
+
+  if (sink < 0) {
+
+    throw std::system_error (errno, std::generic_category (),
+                             "Cannot open benchmark sink");
+
+  }
+
+  ScatterWriter output (sink);
+  std::string buffer;
+
+  visit ("serialize", false,
+    [&] (size_t i) {
+      std::istringstream input (texts[i]);
+      return this->_serializer.Serialize (input).length ();
+    });
+
+  visit ("deserialize", false,
+    [&] (size_t i) {
+      std::istringstream input (records[i]);
+      return this->_serializer.Deserialize (input).length ();
+    });
+
+  visit ("serialize-record", true,
+    [&] (size_t i) {
+      buffer.clear ();
+      this->_serializer.SerializeRecord (texts[i], buffer);
+      return buffer.length ();
+    });
+
+  visit ("deserialize-scatter", true,
+    [&] (size_t i) {
+      this->_serializer.DeserializeLineTo (records[i], output);
+      output.Flush ();
+      return records[i].length ();
+    });
+
+  // Whole records, as DeserializeMatching: the ones that match are written
+  visit ("filter", true,
+    [&] (size_t i) {
+      const bool matches = this->_serializer.DeserializeLineMatching (records[i], filter, output);
+      output.Flush ();
+      return static_cast<size_t> (matches);
+    });
+
+  visit ("lazy-record", true,
+    [&] (size_t i) {
+      size_t length = 0;
+      lazy_record.Reset (records[i]);
+      for (size_t field = 0; field < lazy_record.FieldCount (); ++field) {
+        std::string_view bytes = field < kBenchLazyValues
+                                 ? lazy_record.Value (field)
+                                 : lazy_record.Raw (field);
+        output.Append (bytes.data (), bytes.length ());
+        length += bytes.length ();
+      }
+      output.Flush ();
+      return length;
+    });
+
+  visit ("transcode-json", true,
+    [&] (size_t i) {
+      buffer.clear ();
+      transcoder.TranscodeRecord (records[i], buffer);
+      return buffer.length ();
+    });
+
+  // Private ring, drained in batches as a ring-serve process would do. Hosts
+  // without POSIX shared memory skip it instead of failing the whole run
+  size_t largest_text = 1;
+
+  for (const std::string& text : texts) {
+
+    largest_text = std::max (largest_text, text.length ());
+
+  }
+
+  std::unique_ptr<ShmRing> ring;
+
+  try {
+
+    ring = std::make_unique<ShmRing> (kBenchRingPrefix + std::to_string (getpid ()),
+                                      kBenchRingSlots, static_cast<uint32_t> (largest_text));
+
+  } catch (const transport_error& e) {
+
+    std::cerr << "Skipping 'shm-ring': " << e.what () << std::endl;
+
+  }
+
+  if (ring) {
+
+    RingServer ring_server (this->_serializer, *ring, sink);
+
+    visit ("shm-ring", true,
+      [&] (size_t i) {
+        ring->Push (texts[i]);
+        if (i + 1 == records.size () || 0 == (i + 1) % kDefaultRingBatch) {
+          ring_server.DrainBatch ();
+        }
+        return texts[i].length ();
+      });
+
+  }
+
+  close (sink);
+
+}
+
+/**
+ * @brief Warm up and measure one operation
+ */
+BenchResult Benchmark::Measure (const std::string& operation,
+                                bool steady_state,
+                                const std::vector<std::string>& records,
+                                const Operation& run) const {
+
+  BenchResult result {};
+  result.operation = operation;
+  result.steady_state = steady_state;
+
+  uint64_t corpus_bytes = 0;
+
+  for (size_t i = 0; i < records.size (); ++i) {
+
+    corpus_bytes += records[i].length ();
+    result.result_sum += run (i);
+
+  }
+
+  ResetAllocationPeak ();
+  const AllocationStats before = AllocationSnapshot ();
+  const auto start = std::chrono::steady_clock::now ();
+
+  for (size_t iteration = 0; iteration < this->_iterations; ++iteration) {
+
+    for (size_t i = 0; i < records.size (); ++i) {
+
+      result.result_sum += run (i);
+
+    }
+
+  }
+
+  const std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now () - start;
+  const AllocationStats after = AllocationSnapshot ();
+
+  result.records = this->_iterations * records.size ();
+  result.bytes = this->_iterations * corpus_bytes;
+  result.seconds = elapsed.count ();
+  result.allocations = after.allocations - before.allocations;
+  result.allocated_bytes = after.bytes - before.bytes;
+  result.peak_live_bytes = after.peak_live_bytes - before.live_bytes;
+
+  return result;
+
+}
+
+} /* namespace WAZUH */
@@ -0,0 +1,231 @@
+/*******************************************************************************
+ * @file m_wazuh_columnar_reader.cpp
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-06
+ * @version 1.0.0
+ * @changelog
+ * - v1.0.0: Initial implementation
+ * @brief Columnar Reader implementation
+ *
+ * @details
+ * This file contains the implementation of the WAZUH::ColumnarReader class.
+ * The constructor only validates the header; column blocks are bounds
+ * checked when a value is read, so untouched columns are never read.
+ */
+
+
+/******************************************************************************
+ * Cpp Includes
+ */
+#include "m_wazuh_columnar_reader.h"
+#include "i_wazuh_serializer.h"
+
+
+/******************************************************************************
+ * C includes
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+ * Namespace declaration
+ */
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+constexpr size_t kU32Size = 4;
+constexpr size_t kU64Size = 8;
+constexpr size_t kHeaderSize = kColumnarMagicLength + 2 * kU32Size;
+
+
+/******************************************************************************
+ * Implementation of public functions / methods
+ */
+
+/**
+ * @brief Constructor over a serialized batch
+ */
+ColumnarReader::ColumnarReader (std::string_view batch) :
+  _batch {batch},
+  _record_count {0},
+  _column_count {0},
+  _field_counts_offset {kHeaderSize},
+  _column_offsets_offset {0},
+  _data_offset {0} {
+
+  if (this->_batch.length () < kHeaderSize ||
+      0 != this->_batch.compare (0, kColumnarMagicLength, kColumnarMagic)) {
+
+    throw serializer_error ("Not a columnar batch.");
+
+  }
+
+  this->_record_count = this->ReadU32 (kColumnarMagicLength);
+  this->_column_count = this->ReadU32 (kColumnarMagicLength + kU32Size);
+
+  this->_column_offsets_offset = this->_field_counts_offset +
+                                 this->_record_count * kU32Size;
+  this->_data_offset = this->_column_offsets_offset +
+                       (this->_column_count + 1) * kU64Size;
+
+  if (this->_data_offset > this->_batch.length ()) {
+
+    throw serializer_error ("Truncated columnar batch header.");
+
+  }
+
+  // Column blocks must be in order and large enough for their offsets
+  const size_t data_length = this->_batch.length () - this->_data_offset;
+  uint64_t previous = 0;
+
+  for (size_t column = 0; column <= this->_column_count; ++column) {
+
+    uint64_t start = this->ReadU64 (this->_column_offsets_offset +
+                                    column * kU64Size);
+
+    if (start < previous || start > data_length ||
+        (column > 0 &&
+         start - previous < (this->_record_count + 1) * kU32Size)) {
+
+      throw serializer_error ("Corrupted columnar batch offsets.");
+
+    }
+
+    previous = start;
+
+  }
+
+}
+
+/**
+ * @brief Get the number of records
+ */
+size_t ColumnarReader::RecordCount (void) const {
+
+  return this->_record_count;
+
+}
+
+/**
+ * @brief Get the number of columns
+ */
+size_t ColumnarReader::ColumnCount (void) const {
+
+  return this->_column_count;
+
+}
+
+/**
+ * @brief Get the number of fields of a record
+ */
+size_t ColumnarReader::FieldCount (size_t record) const {
+
+  return this->ReadU32 (this->_field_counts_offset + record * kU32Size);
+
+}
+
+/**
+ * @brief Check whether a record has a value in a column
+ */
+bool ColumnarReader::HasValue (size_t column, size_t record) const {
+
+  return column < this->_column_count &&
+         record < this->_record_count &&
+         column < this->FieldCount (record);
+
+}
+
+/**
+ * @brief Get a value
+ */
+std::string_view ColumnarReader::Value (size_t column, size_t record) const {
+
+  std::string_view value;
+
+  if (this->HasValue (column, record)) {
+
+    const size_t block_offset = this->_column_offsets_offset +
+                                column * kU64Size;
+    const size_t block_start = this->_data_offset + this->ReadU64 (block_offset);
+    const size_t block_end = this->_data_offset +
+                             this->ReadU64 (block_offset + kU64Size);
+
+    const size_t bytes_start = block_start +
+                               (this->_record_count + 1) * kU32Size;
+    const size_t value_start = this->ReadU32 (block_start + record * kU32Size);
+    const size_t value_end = this->ReadU32 (block_start +
+                                            (record + 1) * kU32Size);
+
+    if (value_start > value_end || bytes_start + value_end > block_end) {
+
+      throw serializer_error ("Corrupted columnar batch column.");
+
+    }
+
+    value = this->_batch.substr (bytes_start + value_start,
+                                 value_end - value_start);
+
+  }
+
+  return value;
+
+}
+
+
+/******************************************************************************
+ * Implementation of protected functions / methods
+ */
+
+
+/******************************************************************************
+ * Implementation of private functions / methods
+ */
+
+/**
+ * @brief Read a little endian 32 bits integer
+ */
+uint32_t ColumnarReader::ReadU32 (size_t offset) const {
+
+  uint32_t value = 0;
+
+  for (size_t i = 0; i < kU32Size; ++i) {
+
+    value |= static_cast<uint32_t> (
+               static_cast<unsigned char> (this->_batch[offset + i])) << (8 * i);
+
+  }
+
+  return value;
+
+}
+
+/**
+ * @brief Read a little endian 64 bits integer
+ */
+uint64_t ColumnarReader::ReadU64 (size_t offset) const {
+
+  uint64_t value = 0;
+
+  for (size_t i = 0; i < kU64Size; ++i) {
+
+    value |= static_cast<uint64_t> (
+               static_cast<unsigned char> (this->_batch[offset + i])) << (8 * i);
+
+  }
+
+  return value;
+
+}
+
+} /* namespace WAZUH */
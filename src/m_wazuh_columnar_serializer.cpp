@@ -0,0 +1,292 @@
+/*******************************************************************************
+ * @file m_wazuh_columnar_serializer.cpp
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-06
+ * @version 1.1.0
+ * @changelog
+ * - v1.0.0: Initial implementation
+ * - v1.1.0: Multi byte delimiters
+ * @brief Columnar Serializer implementation
+ *
+ * @details
+ * This file contains the implementation of the WAZUH::ColumnarSerializer
+ * class. Records are split with the delimited format rules and their fields
+ * appended, still escaped, to one buffer per column, which are then laid
+ * out one after the other behind the batch header. Keeping the escaped
+ * bytes gives back the exact records, whatever escapes they use.
+ */
+
+
+/******************************************************************************
+ * Cpp Includes
+ */
+#include "m_wazuh_columnar_serializer.h"
+#include "m_wazuh_columnar_reader.h"
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+
+/******************************************************************************
+ * C includes
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+ * Namespace declaration
+ */
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+
+
+/******************************************************************************
+* Class / Interfaces / Structs / Enums / Typedefs / Using declarations
+*/
+
+/**
+ * @brief Column being built: value offsets and concatenated bytes
+ */
+struct ColumnBuilder {
+  std::vector<uint32_t> offsets;
+  std::string bytes;
+};
+
+
+/******************************************************************************
+ * Local functions
+ */
+
+/**
+ * @brief Append a little endian 32 bits integer
+ */
+static void AppendU32 (std::string& output, uint32_t value) {
+
+  for (size_t i = 0; i < sizeof (value); ++i) {
+
+    output += static_cast<char> ((value >> (8 * i)) & 0xFF);
+
+  }
+
+}
+
+/**
+ * @brief Append a little endian 64 bits integer
+ */
+static void AppendU64 (std::string& output, uint64_t value) {
+
+  for (size_t i = 0; i < sizeof (value); ++i) {
+
+    output += static_cast<char> ((value >> (8 * i)) & 0xFF);
+
+  }
+
+}
+
+/**
+ * @brief Read a whole stream
+ */
+static std::string ReadAll (std::istream& input) {
+
+  return std::string ((std::istreambuf_iterator<char> (input)),
+                      std::istreambuf_iterator<char> ());
+
+}
+
+
+/******************************************************************************
+ * Implementation of public functions / methods
+ */
+
+/**
+ * @brief Constructor with delimiter
+ */
+ColumnarSerializer::ColumnarSerializer (const std::string& delimiter) :
+  _delimited {delimiter} {
+
+}
+
+/**
+ * @brief Serialize delimited records into a columnar batch
+ */
+std::string ColumnarSerializer::Serialize (std::istream& input) const {
+
+  std::vector<ColumnBuilder> columns;
+  std::vector<uint32_t> field_counts;
+  std::string line;
+
+  while (std::getline (input, line)) {
+
+    const size_t record = field_counts.size ();
+    size_t column = 0;
+    size_t start = 0;
+
+    for (;;) {
+
+      size_t end = this->_delimited.FindDelimiter (line, start);
+      if (std::string::npos == end) { end = line.length (); }
+
+      // A new column has empty values for all the previous records
+      if (column == columns.size ()) {
+
+        columns.emplace_back ();
+        columns.back ().offsets.assign (record + 1, 0);
+
+      }
+
+      ColumnBuilder& builder = columns[column];
+      builder.bytes.append (line, start, end - start);
+
+      if (builder.bytes.length () > std::numeric_limits<uint32_t>::max ()) {
+
+        throw serializer_error ("Column " + std::to_string (column) +
+                                " exceeds the columnar batch size limit.");
+
+      }
+
+      builder.offsets.push_back (static_cast<uint32_t> (builder.bytes.length ()));
+      ++column;
+
+      if (end == line.length ()) { break; }
+
+      start = end + this->_delimited.Delimiter ().length ();
+
+    }
+
+    // Shorter records leave the remaining columns empty
+    for (size_t i = column; i < columns.size (); ++i) {
+
+      columns[i].offsets.push_back (columns[i].offsets.back ());
+
+    }
+
+    if (field_counts.size () == std::numeric_limits<uint32_t>::max ()) {
+
+      throw serializer_error ("Too many records for a columnar batch.");
+
+    }
+
+    field_counts.push_back (static_cast<uint32_t> (column));
+
+  }
+
+  // Record field counts are bound by the column count
+  if (columns.size () > std::numeric_limits<uint32_t>::max ()) {
+
+    throw serializer_error ("Too many columns for a columnar batch.");
+
+  }
+
+  std::string batch (kColumnarMagic, kColumnarMagicLength);
+  AppendU32 (batch, static_cast<uint32_t> (field_counts.size ()));
+  AppendU32 (batch, static_cast<uint32_t> (columns.size ()));
+
+  for (uint32_t count : field_counts) {
+
+    AppendU32 (batch, count);
+
+  }
+
+  uint64_t column_offset = 0;
+
+  for (const auto& builder : columns) {
+
+    AppendU64 (batch, column_offset);
+    column_offset += builder.offsets.size () * sizeof (uint32_t) +
+                     builder.bytes.length ();
+
+  }
+
+  AppendU64 (batch, column_offset);
+
+  for (const auto& builder : columns) {
+
+    for (uint32_t offset : builder.offsets) {
+
+      AppendU32 (batch, offset);
+
+    }
+
+    batch += builder.bytes;
+
+  }
+
+  return batch;
+
+}
+
+/**
+ * @brief Deserialize a columnar batch into delimited records
+ */
+std::string ColumnarSerializer::Deserialize (std::istream& input) const {
+
+  std::string batch = ReadAll (input);
+  ColumnarReader reader (batch);
+  std::string deserialized;
+
+  for (size_t record = 0; record < reader.RecordCount (); ++record) {
+
+    const size_t fields = reader.FieldCount (record);
+
+    for (size_t column = 0; column < fields; ++column) {
+
+      if (column > 0) { deserialized += this->_delimited.Delimiter (); }
+
+      deserialized += reader.Value (column, record);
+
+    }
+
+    deserialized += '\n';
+
+  }
+
+  return deserialized;
+
+}
+
+/**
+ * @brief Extract a single column from a columnar batch
+ */
+std::string ColumnarSerializer::DeserializeColumn (std::istream& input,
+                                                   size_t column) const {
+
+  std::string batch = ReadAll (input);
+  ColumnarReader reader (batch);
+  std::string deserialized;
+
+  for (size_t record = 0; record < reader.RecordCount (); ++record) {
+
+    if (reader.HasValue (column, record)) {
+
+      deserialized += reader.Value (column, record);
+      deserialized += '\n';
+
+    }
+
+  }
+
+  return deserialized;
+
+}
+
+
+/******************************************************************************
+ * Implementation of protected functions / methods
+ */
+
+} /* namespace WAZUH */
@@ -0,0 +1,216 @@
+/*******************************************************************************
+ * @file m_wazuh_crc32c.cpp
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-07
+ * @version 1.0.0
+ * @changelog
+ * - v1.0.0: Initial implementation
+ * @brief CRC32C implementation
+ *
+ * @details
+ * This file contains the implementation of the CRC32C checksum. The SSE4.2
+ * version is compiled for that target only and selected at run time, so the
+ * binary still runs on CPUs without the instruction. Checksums are combined
+ * as in zlib, multiplying by x^(8n) modulo the polynomial.
+ */
+
+
+/******************************************************************************
+ * Cpp Includes
+ */
+#include "m_wazuh_crc32c.h"
+
+#include <array>
+#include <cstring>
+
+
+/******************************************************************************
+ * C includes
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <nmmintrin.h>
+#define WAZUH_CRC32C_HAS_SSE42 1
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+ * Namespace declaration
+ */
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+constexpr uint32_t kCrc32cPolynomial = 0x82F63B78;  // Reflected Castagnoli
+constexpr uint32_t kCrc32cOne = 0x80000000;         // x^0, reflected
+
+
+/******************************************************************************
+ * Local functions
+ */
+
+/**
+ * @brief Build the byte table of the software version
+ */
+static std::array<uint32_t, 256> BuildCrc32cTable (void) {
+
+  std::array<uint32_t, 256> table {};
+
+  for (uint32_t i = 0; i < table.size (); ++i) {
+
+    uint32_t crc = i;
+
+    for (int bit = 0; bit < 8; ++bit) {
+
+      crc = (crc >> 1) ^ ((crc & 1) ? kCrc32cPolynomial : 0);
+
+    }
+
+    table[i] = crc;
+
+  }
+
+  return table;
+
+}
+
+/**
+ * @brief Software CRC32C, one byte per table lookup
+ */
+static uint32_t Crc32cSoftware (const char* data, size_t length, uint32_t crc) {
+
+  static const std::array<uint32_t, 256> table = BuildCrc32cTable ();
+
+  for (size_t i = 0; i < length; ++i) {
+
+    crc = table[(crc ^ static_cast<unsigned char> (data[i])) & 0xFF] ^
+          (crc >> 8);
+
+  }
+
+  return crc;
+
+}
+
+/**
+ * @brief Multiply two polynomials modulo the CRC32C polynomial
+ */
+static uint32_t MultiplyModulo (uint32_t a, uint32_t b) {
+
+  uint32_t product = 0;
+
+  for (uint32_t bit = kCrc32cOne; 0 != bit; bit >>= 1) {
+
+    if (a & bit) { product ^= b; }
+
+    b = (b & 1) ? (b >> 1) ^ kCrc32cPolynomial : b >> 1;
+
+  }
+
+  return product;
+
+}
+
+/**
+ * @brief Compute x^(8 * length) modulo the CRC32C polynomial
+ */
+static uint32_t ShiftBytes (size_t length) {
+
+  uint32_t result = kCrc32cOne;
+  uint32_t square = kCrc32cOne >> 8;      // x^8, reflected
+
+  for (; 0 != length; length >>= 1) {
+
+    if (length & 1) { result = MultiplyModulo (square, result); }
+
+    square = MultiplyModulo (square, square);
+
+  }
+
+  return result;
+
+}
+
+#ifdef WAZUH_CRC32C_HAS_SSE42
+
+/**
+ * @brief Hardware CRC32C, eight bytes per crc32 instruction
+ */
+__attribute__ ((target ("sse4.2")))
+static uint32_t Crc32cHardware (const char* data, size_t length, uint32_t crc) {
+
+#if defined(__x86_64__)
+  uint64_t crc64 = crc;
+
+  while (length >= sizeof (uint64_t)) {
+
+    uint64_t word;
+    std::memcpy (&word, data, sizeof (word));
+    crc64 = _mm_crc32_u64 (crc64, word);
+
+    data += sizeof (word);
+    length -= sizeof (word);
+
+  }
+
+  crc = static_cast<uint32_t> (crc64);
+#endif
+
+  while (length > 0) {
+
+    crc = _mm_crc32_u8 (crc, static_cast<unsigned char> (*data));
+
+    ++data;
+    --length;
+
+  }
+
+  return crc;
+
+}
+
+#endif
+
+
+/******************************************************************************
+ * Implementation of public functions / methods
+ */
+
+/**
+ * @brief Compute or extend a CRC32C checksum
+ */
+uint32_t Crc32c (const char* data, size_t length, uint32_t crc) {
+
+#ifdef WAZUH_CRC32C_HAS_SSE42
+  static const bool has_sse42 = __builtin_cpu_supports ("sse4.2");
+
+  if (has_sse42) {
+
+    return ~Crc32cHardware (data, length, ~crc);
+
+  }
+#endif
+
+  return ~Crc32cSoftware (data, length, ~crc);
+
+}
+
+/**
+ * @brief Combine the checksums of two consecutive buffers
+ */
+uint32_t Crc32cCombine (uint32_t crc1, uint32_t crc2, size_t length2) {
+
+  return MultiplyModulo (ShiftBytes (length2), crc1) ^ crc2;
+
+}
+
+} /* namespace WAZUH */
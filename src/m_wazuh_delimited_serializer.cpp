@@ -2,9 +2,18 @@
  * @file m_wazuh_delimited_serializer.cpp
  * @author Roberto Enrique Castro Beltran
  * @date 2025-11-03
- * @version 1.0.0
+ * @version 1.8.0
  * @changelog
  * - v1.0.0: Initial implementation
+ * - v1.1.0: Scatter-gather deserialization
+ * - v1.2.0: Buffer based entry points for batch processing
+ * - v1.3.0: Optional CRC32C record trailer
+ * - v1.4.0: Filtered deserialization of record streams
+ * - v1.5.0: Multi byte delimiters
+ * - v1.6.0: Record serialization into a caller buffer
+ * - v1.6.1: Serialize input read in blocks
+ * - v1.7.0: UTF-8 validation policy
+ * - v1.8.0: Exact size two pass serialization
  * @brief Delimited Serializer implementation
  *
  * @details
@@ -18,9 +27,16 @@
  * Cpp Includes
  */
 #include "m_wazuh_delimited_serializer.h"
+#include "m_wazuh_crc32c.h"
+#include "m_wazuh_record_filter.h"
+#include "m_wazuh_simd_search.h"
 
+#include <algorithm>
+#include <cstring>
+#include <string>
 #include <vector>
 #include <iostream>
+#include <utility>
 
 
 /******************************************************************************
@@ -43,12 +59,112 @@ extern "C" {
 namespace WAZUH {
 
 
+/******************************************************************************
+* Constants and macros definitions
+*/
+constexpr char kNewLine[] = "\n";
+
+constexpr char kChecksumMarker[] = "\\#";
+constexpr size_t kChecksumMarkerLength = sizeof (kChecksumMarker) - 1;
+constexpr size_t kChecksumDigits = 8;
+constexpr size_t kChecksumLength = kChecksumMarkerLength + kChecksumDigits;
+constexpr char kHexDigits[] = "0123456789abcdef";
+
+constexpr char kReplacementCharacter[] = "\xEF\xBF\xBD";   // U+FFFD
+constexpr char kByteEscape[] = "x";
+
+constexpr size_t kStreamBlockSize = 1 << 20;
+constexpr size_t kReadBlockSize = 4096;
+
+// Escaped length of a byte: 0 dropped, 1 copied, 2 prefixed with '\'
+constexpr uint8_t kByteDropped = 0;
+constexpr uint8_t kByteCopied = 1;
+constexpr uint8_t kByteEscaped = 2;
+constexpr size_t kByteEscapeLength = 2 + 2;       // '\x' and two hex digits
+
+
 /******************************************************************************
  * Implementation of public functions / methods
  */
 
- DelimitedSerializer::DelimitedSerializer
- (char delimiter) : _delimiter {delimiter} {
+/**
+ * @brief Constructor with delimiter
+ */
+DelimitedSerializer::DelimitedSerializer (std::string delimiter) :
+  _delimiter {std::move (delimiter)}, _checksum {false},
+  _utf8_policy {Utf8Policy::kAccept}, _escaped_lengths {} {
+
+  if (_delimiter.empty ()) {
+
+    throw serializer_error ("Delimiter cannot be empty.");
+
+  }
+
+  // These would be mistaken for escape sequences or split the record
+  if ('n' == _delimiter[0] ||
+      std::string::npos != _delimiter.find_first_of ("\\\n")) {
+
+    throw serializer_error ("Delimiter cannot contain '\\' or new lines, "
+                            "nor start with 'n'.");
+
+  }
+
+  // Byte classes shared by the size scan and the escape kernel. Only the
+  // first byte of the delimiter needs to be escaped
+  _escaped_lengths.fill (kByteCopied);
+  _escaped_lengths[static_cast<unsigned char> ('\\')] = kByteEscaped;
+  _escaped_lengths[static_cast<unsigned char> ('\n')] = kByteEscaped;
+  _escaped_lengths[static_cast<unsigned char> ('\r')] = kByteDropped;
+  _escaped_lengths[static_cast<unsigned char> (_delimiter[0])] = kByteEscaped;
+
+}
+
+/**
+ * @brief Enable or disable the CRC32C trailer of serialized records
+ */
+void DelimitedSerializer::SetChecksum (bool enabled) {
+
+  if (enabled && '#' == _delimiter[0]) {
+
+    throw serializer_error ("Delimiter starting with '#' is reserved by the checksum trailer.");
+
+  }
+
+  _checksum = enabled;
+
+}
+
+/**
+ * @brief Check whether the CRC32C trailer is enabled
+ */
+bool DelimitedSerializer::HasChecksum (void) const {
+
+  return _checksum;
+
+}
+
+/**
+ * @brief Set what EscapeField does with malformed UTF-8
+ */
+void DelimitedSerializer::SetUtf8Policy (Utf8Policy policy) {
+
+  // '\x' would read back as an escaped delimiter
+  if (Utf8Policy::kEscape == policy && kByteEscape[0] == _delimiter[0]) {
+
+    throw serializer_error ("Delimiter starting with 'x' is reserved by the UTF-8 byte escape.");
+
+  }
+
+  _utf8_policy = policy;
+
+}
+
+/**
+ * @brief Get what EscapeField does with malformed UTF-8
+ */
+Utf8Policy DelimitedSerializer::GetUtf8Policy (void) const {
+
+  return _utf8_policy;
 
 }
 
@@ -57,29 +173,94 @@ namespace WAZUH {
 */
 std::string DelimitedSerializer::Serialize (std::istream& input) const {
 
- std::vector<std::string> fields;
- std::string line;
- std::string serialized;
+  // Read the whole input until EOF, every line is a field. Whole blocks are
+  // copied: profile guided builds keep the per byte istreambuf_iterator
+  // read out of line, a call for every byte
+  std::string text;
+  char block[kReadBlockSize];
+
+  for (;;) {
+
+    input.read (block, kReadBlockSize);
+    const std::streamsize count = input.gcount ();
+
+    if (count <= 0) { break; }
+
+    text.append (block, static_cast<size_t> (count));
+
+  }
+
+  std::string serialized;
+
+  this->SerializeRecord (text, serialized);
+
+  return serialized;
 
- // Read lines from input until EOF
- while (std::getline (input, line)) {
+}
+
+
+/**
+ * @brief Serialize a text buffer as a complete record
+ */
+void DelimitedSerializer::SerializeRecord (std::string_view text,
+                                           std::string& serialized) const {
+
+  // One resize, at most one allocation, then everything is written in place
+  bool valid = true;
+  const size_t start = serialized.length ();
+  const size_t size = this->FieldsSize (text, valid) + (_checksum ? kChecksumLength : 0);
+
+  serialized.resize (start + size);
+  this->WriteRecord (text, &serialized[start], valid);
+
+}
+
+
+/**
+ * @brief Serialize a text buffer as a complete record into a caller buffer
+ */
+size_t DelimitedSerializer::SerializeRecordTo (std::string_view text,
+                                               char* buffer,
+                                               size_t capacity) const {
+
+  bool valid = true;
+  const size_t size = this->FieldsSize (text, valid) + (_checksum ? kChecksumLength : 0);
+
+  if (size > capacity) {
 
-   fields.push_back(line);
+    throw serializer_error ("Record of " + std::to_string (size) +
+                            " bytes does not fit a buffer of " +
+                            std::to_string (capacity) + ".");
 
- }
+  }
+
+  this->WriteRecord (text, buffer, valid);
 
- // Serialize all fields with the specified delimiter
- bool first = true;
- for (const auto& field : fields) {
+  return size;
+
+}
 
-   if (!first) { serialized += _delimiter; }
-   else { first = false; }
 
-   serialized += EscapeField (field);
+/**
+ * @brief Get the exact size of the record SerializeRecord writes
+ */
+size_t DelimitedSerializer::SerializedSize (std::string_view text) const {
 
- }
+  bool valid = true;
 
- return serialized;
+  return this->FieldsSize (text, valid) + (_checksum ? kChecksumLength : 0);
+
+}
+
+
+/**
+ * @brief Get the exact size of an escaped field
+ */
+size_t DelimitedSerializer::EscapedSize (std::string_view field) const {
+
+  bool valid = true;
+
+  return this->ScanField (field, valid);
 
 }
 
@@ -95,64 +276,486 @@ std::string DelimitedSerializer::Deserialize (std::istream& input) const {
   // Read the serialized line
   if (std::getline (input, line)) {
 
-    std::vector<std::string> fields;
-    std::string current_field;
+    if (_checksum) {
+
+      uint32_t expected = 0;
+      uint32_t crc = 0;
 
-    for (size_t i = 0; i < line.length (); ++i) {
+      std::string_view payload = this->SplitChecksum (line, expected);
+      this->DeserializeFields (payload, deserialized, &crc);
 
-      if (line[i] == '\\' && i + 1 < line.length ()) {
+      if (crc != expected) {
 
-        // Handle escaped characters
-        char next = line[i + 1];
-        if (next == '\\') {
+        throw serializer_error ("Checksum mismatch, the record is corrupted.");
 
-          current_field += '\\';
-          ++i; // Skip next character
+      }
+
+    } else {
 
-        } else if (next == 'n') {
+      this->DeserializeFields (line, deserialized, nullptr);
 
-          current_field += '\n';
-          ++i; // Skip next character
+    }
 
-        } else if (next == _delimiter) {
+  }
 
-          current_field += _delimiter;
-          ++i; // Skip next character
+  return deserialized;
 
-        } else {
+}
 
-          // Unknown escape sequence, treat as literal
-          current_field += line[i];
 
-        }
+/**
+ * @brief Serialize a text buffer whose lines are the fields
+ */
+std::string DelimitedSerializer::SerializeText (std::string_view text,
+                                                uint32_t* crc) const {
+
+  bool valid = true;
+  std::string serialized (this->FieldsSize (text, valid), '\0');
+
+  if (nullptr != crc) { *crc = 0; }
+
+  this->WriteFields (text, &serialized[0], crc, valid);
+
+  return serialized;
+
+}
+
+
+/**
+ * @brief Deserialize a serialized line into fields, one per line
+ */
+std::string DelimitedSerializer::DeserializeLine (std::string_view line,
+                                                  uint32_t* crc) const {
+
+  std::string deserialized;
+
+  if (nullptr != crc) { *crc = 0; }
+
+  this->DeserializeFields (line, deserialized, crc);
+
+  return deserialized;
+
+}
+
+
+/**
+ * @brief Append the checksum trailer to a serialized record
+ */
+void DelimitedSerializer::AppendChecksum (std::string& serialized,
+                                          uint32_t crc) const {
 
-      } else if (line[i] == _delimiter) {
+  const size_t start = serialized.length ();
 
-        // Found unescaped delimiter, end current field
-        fields.push_back (current_field);
-        current_field.clear ();
+  serialized.resize (start + kChecksumLength);
+  this->WriteChecksum (crc, &serialized[start]);
+
+}
+
+
+/**
+ * @brief Check the checksum trailer of a whole serialized line
+ */
+std::string_view DelimitedSerializer::VerifyChecksum (std::string_view line) const {
+
+  uint32_t expected = 0;
+  std::string_view payload = this->SplitChecksum (line, expected);
+
+  if (Crc32c (payload.data (), payload.length ()) != expected) {
+
+    throw serializer_error ("Checksum mismatch, the record is corrupted.");
+
+  }
+
+  return payload;
+
+}
+
+
+/**
+ * @brief Split the checksum trailer from a serialized line
+ */
+std::string_view DelimitedSerializer::SplitChecksum (std::string_view line,
+                                                     uint32_t& crc) const {
+
+  if (line.length () < kChecksumLength ||
+      0 != line.compare (line.length () - kChecksumLength,
+                         kChecksumMarkerLength, kChecksumMarker)) {
+
+    throw serializer_error ("Missing checksum trailer.");
+
+  }
+
+  const size_t trailer = line.length () - kChecksumLength;
+
+  crc = 0;
+
+  for (size_t i = trailer + kChecksumMarkerLength; i < line.length (); ++i) {
+
+    char c = line[i];
+    uint32_t digit = 0;
+
+    if (c >= '0' && c <= '9') { digit = c - '0'; }
+    else if (c >= 'a' && c <= 'f') { digit = c - 'a' + 10; }
+    else if (c >= 'A' && c <= 'F') { digit = c - 'A' + 10; }
+    else { throw serializer_error ("Malformed checksum trailer."); }
+
+    crc = (crc << 4) | digit;
+
+  }
+
+  return line.substr (0, trailer);
+
+}
+
+
+/**
+ * @brief Find the first unescaped delimiter at or after a position
+ */
+size_t DelimitedSerializer::FindDelimiter (std::string_view line,
+                                           size_t from) const {
+
+  // Same cost for any delimiter length, long ones use the SIMD search
+  auto search = [this, line] (size_t start) {
+    return 1 == _delimiter.length () ? line.find (_delimiter[0], start)
+                                     : FindSubstring (line, _delimiter, start);
+  };
+
+  size_t position = search (from);
+
+  while (std::string_view::npos != position) {
+
+    // A delimiter is escaped when an odd run of backslashes precedes it
+    size_t backslashes = 0;
+    while (backslashes < position &&
+           '\\' == line[position - backslashes - 1]) {
+
+      ++backslashes;
+
+    }
+
+    if (0 == backslashes % 2) { break; }
+
+    position = search (position + 1);
+
+  }
+
+  return position;
+
+}
+
+
+/**
+ * @brief Get the delimiter
+ */
+const std::string& DelimitedSerializer::Delimiter (void) const {
+
+  return _delimiter;
+
+}
+
+
+/**
+ * @brief Escape a field by escaping delimiters and special characters
+ */
+void DelimitedSerializer::EscapeField (std::string_view field,
+                                       std::string& escaped) const {
+
+  bool valid = true;
+  const size_t start = escaped.length ();
+
+  escaped.resize (start + this->ScanField (field, valid));
+
+  if (valid) {
+
+    this->WriteEscaped (field, &escaped[start]);
+
+  } else {
+
+    this->EscapeInvalidUtf8 (field, &escaped[start]);
+
+  }
+
+}
+
+
+/**
+ * @brief Escape bytes the way they appear in a serialized field
+ */
+void DelimitedSerializer::EscapeLiteral (std::string_view bytes,
+                                         std::string& escaped) const {
+
+  const char first = _delimiter[0];
+
+  for (char c : bytes) {
+
+    if ('\\' == c || '\n' == c || first == c) {
+
+      escaped += '\\';
+      escaped += '\n' == c ? 'n' : c;
+
+    } else {
+
+      escaped += c;
+
+    }
+
+  }
+
+}
+
+
+/**
+ * @brief Unescape a single serialized field and append it to a string
+ */
+void DelimitedSerializer::UnescapeField (std::string_view field,
+                                         std::string& unescaped) const {
+
+  const char first = _delimiter[0];
+
+  for (size_t i = 0; i < field.length (); ++i) {
+
+    if (field[i] == '\\' && i + 1 < field.length ()) {
+
+      char next = field[i + 1];
+      if (next == '\\') {
+
+        unescaped += '\\';
+        ++i; // Skip next character
+
+      } else if (next == 'n') {
+
+        unescaped += '\n';
+        ++i; // Skip next character
+
+      } else if (next == first) {
+
+        unescaped += first;
+        ++i; // Skip next character
 
       } else {
 
-        current_field += line[i];
+        // Unknown escape sequence, treat as literal
+        unescaped += field[i];
 
       }
 
+    } else {
+
+      unescaped += field[i];
+
     }
 
-    // Add the last field
-    fields.push_back (current_field);
+  }
+
+}
+
+
+/**
+ * @brief Deserialize input stream straight into a scatter writer
+ */
+void DelimitedSerializer::DeserializeTo (std::istream& input,
+                                         ScatterWriter& output) const {
 
-    // Output each field on a separate line
-    for (const auto& field : fields) {
+  std::string line;
 
-      deserialized += field + "\n";
+  // Read the serialized line
+  if (std::getline (input, line)) {
+
+    this->DeserializeLineTo (line, output);
+
+    // Spans point into 'line', they must be written before it goes away
+    output.Flush ();
+
+  }
+
+}
+
+
+/**
+ * @brief Deserialize the records of a stream that match a filter
+ */
+void DelimitedSerializer::DeserializeMatching (std::istream& input,
+                                               const RecordFilter& filter,
+                                               ScatterWriter& output) const {
+
+  std::string buffer;
+  bool end_of_input = false;
+
+  while (!end_of_input) {
+
+    // Read a block; spans of the records found in it stay valid until the
+    // block is flushed, so there is one write per block and not per record
+    const size_t kept = buffer.length ();
+    buffer.resize (kept + kStreamBlockSize);
+    input.read (&buffer[kept], kStreamBlockSize);
+    buffer.resize (kept + static_cast<size_t> (input.gcount ()));
+    end_of_input = !input;
+
+    std::string_view block (buffer);
+    size_t processed = 0;
+
+    try {
+
+      for (;;) {
+
+        size_t line_end = block.find ('\n', processed);
+
+        if (std::string_view::npos == line_end) {
+
+          // A last line without new line is still a record
+          if (!end_of_input || processed >= block.length ()) { break; }
+          line_end = block.length ();
+
+        }
+
+        std::string_view line = block.substr (processed, line_end - processed);
+        processed = line_end + 1;
+
+        this->DeserializeLineMatching (line, filter, output);
+
+      }
+
+    } catch (const serializer_error&) {
+
+      // Records before the failing one are valid, do not lose them
+      output.Flush ();
+      throw;
 
     }
 
+    output.Flush ();
+    buffer.erase (0, std::min (processed, buffer.length ()));
+
   }
 
-  return deserialized;
+}
+
+
+/**
+ * @brief Deserialize a serialized line if it matches a filter
+ */
+bool DelimitedSerializer::DeserializeLineMatching (std::string_view line,
+                                                   const RecordFilter& filter,
+                                                   ScatterWriter& output) const {
+
+  std::string_view payload = line;
+
+  // The trailer is only checked for the records that are written
+  if (_checksum) {
+
+    uint32_t expected = 0;
+    payload = this->SplitChecksum (line, expected);
+
+  }
+
+  const bool matches = filter.Matches (payload);
+
+  if (matches) {
+
+    this->DeserializeLineTo (line, output);
+
+  }
+
+  return matches;
+
+}
+
+
+/**
+ * @brief Deserialize a serialized line straight into a scatter writer
+ */
+void DelimitedSerializer::DeserializeLineTo (std::string_view line,
+                                             ScatterWriter& output) const {
+
+  uint32_t expected = 0;
+  uint32_t crc = 0;
+  std::string_view payload = line;
+
+  if (_checksum) {
+
+    payload = this->SplitChecksum (line, expected);
+
+  }
+
+  const char* data = payload.data ();
+  const size_t length = payload.length ();
+  const char first = _delimiter[0];
+
+  // Spans queued before this record, kept if the record is rejected
+  const size_t first_span = output.Size ();
+
+  // Start of the run of bytes that are copied verbatim to the output
+  size_t span_start = 0;
+
+  // Start of the bytes not yet added to the checksum
+  size_t crc_start = 0;
+
+  for (size_t i = 0; i < length; ++i) {
+
+    if (data[i] == '\\' && i + 1 < length) {
+
+      char next = data[i + 1];
+      if (next == '\\') {
+
+        // The escaped byte is its own output, only the backslash is dropped
+        output.Append (data + span_start, i - span_start);
+        ++i; // Skip next character
+        span_start = i;
+
+      } else if (next == 'n') {
+
+        output.Append (data + span_start, i - span_start);
+        output.Append (kNewLine, 1);
+        ++i; // Skip next character
+        span_start = i + 1;
+
+      } else if (next == first) {
+
+        output.Append (data + span_start, i - span_start);
+        ++i; // Skip next character
+        span_start = i;
+
+      }
+
+      // Unknown escape sequence, treat as literal and keep it in the span
+
+    } else if (data[i] == first &&
+               0 == payload.compare (i, _delimiter.length (), _delimiter)) {
+
+      // Found unescaped delimiter, end current field
+      output.Append (data + span_start, i - span_start);
+      output.Append (kNewLine, 1);
+      i += _delimiter.length () - 1; // Skip the rest of the delimiter
+      span_start = i + 1;
+
+      if (_checksum) {
+
+        crc = Crc32c (data + crc_start, i + 1 - crc_start, crc);
+        crc_start = i + 1;
+
+      }
+
+    }
+
+  }
+
+  // Add the last field
+  output.Append (data + span_start, length - span_start);
+  output.Append (kNewLine, 1);
+
+  if (_checksum) {
+
+    crc = Crc32c (data + crc_start, length - crc_start, crc);
+
+    // Nothing of the record has been written yet, drop it entirely
+    if (crc != expected) {
+
+      output.Discard (first_span);
+      throw serializer_error ("Checksum mismatch, the record is corrupted.");
+
+    }
+
+  }
 
 }
 
@@ -166,50 +769,340 @@ std::string DelimitedSerializer::Deserialize (std::istream& input) const {
  * Implementation of private functions / methods
  */
 
+/**
+ * @brief Get the size of the serialized lines of a text buffer
+ */
+size_t DelimitedSerializer::FieldsSize (std::string_view text, bool& valid) const {
+
+  bool field_valid = true;
+  size_t size = 0;
+  size_t fields = 0;
+  size_t line_start = 0;
+
+  while (line_start < text.length ()) {
+
+    size_t line_end = text.find ('\n', line_start);
+    if (std::string_view::npos == line_end) { line_end = text.length (); }
+
+    size += this->ScanField (text.substr (line_start, line_end - line_start), field_valid);
+    valid = valid && field_valid;
+    ++fields;
+
+    line_start = line_end + 1;
+
+  }
+
+  return 0 == fields ? 0 : size + (fields - 1) * _delimiter.length ();
+
+}
 
 /**
- * @brief Escape a field by escaping delimiters and special characters
+ * @brief Write the serialized lines of a text buffer
  */
-std::string DelimitedSerializer::EscapeField (const std::string& field) const {
+char* DelimitedSerializer::WriteFields (std::string_view text, char* out,
+                                        uint32_t* crc, bool valid) const {
+
+  // Serialize all fields with the specified delimiter
+  bool first = true;
+  size_t line_start = 0;
+
+  while (line_start < text.length ()) {
+
+    size_t line_end = text.find ('\n', line_start);
+    if (std::string_view::npos == line_end) { line_end = text.length (); }
+
+    char* const field_start = out;
+
+    if (!first) {
+
+      std::memcpy (out, _delimiter.data (), _delimiter.length ());
+      out += _delimiter.length ();
+
+    } else {
+
+      first = false;
 
-  std::string escaped;
+    }
+
+    // Fields of a record the size pass found well formed are not validated
+    // again, malformed ones, rare, go through the policy
+    std::string_view field = text.substr (line_start, line_end - line_start);
+    out = valid ? this->WriteEscaped (field, out) : this->WriteField (field, out);
+
+    // Checksum the delimiter and the field just written, still in L1
+    if (nullptr != crc) {
+
+      *crc = Crc32c (field_start, out - field_start, *crc);
+
+    }
+
+    line_start = line_end + 1;
+
+  }
+
+  return out;
+
+}
+
+/**
+ * @brief Write a complete record, of SerializedSize bytes
+ */
+char* DelimitedSerializer::WriteRecord (std::string_view text, char* out,
+                                        bool valid) const {
+
+  if (_checksum) {
+
+    uint32_t crc = 0;
+
+    out = this->WriteFields (text, out, &crc, valid);
+    out = this->WriteChecksum (crc, out);
+
+  } else {
+
+    out = this->WriteFields (text, out, nullptr, valid);
+
+  }
+
+  return out;
+
+}
+
+/**
+ * @brief Write the checksum trailer
+ */
+char* DelimitedSerializer::WriteChecksum (uint32_t crc, char* out) const {
+
+  std::memcpy (out, kChecksumMarker, kChecksumMarkerLength);
+  out += kChecksumMarkerLength;
+
+  for (size_t i = kChecksumDigits; i > 0; --i) {
+
+    *out++ = kHexDigits[(crc >> (4 * (i - 1))) & 0xF];
+
+  }
+
+  return out;
+
+}
+
+/**
+ * @brief Size an escaped field and tell whether it is well formed
+ */
+size_t DelimitedSerializer::ScanField (std::string_view field, bool& valid) const {
+
+  valid = Utf8Policy::kAccept == _utf8_policy || IsValidUtf8 (field);
+
+  return valid ? this->CountEscaped (field) : this->EscapeInvalidUtf8 (field, nullptr);
+
+}
+
+/**
+ * @brief Write an escaped field, of EscapedSize bytes
+ */
+char* DelimitedSerializer::WriteField (std::string_view field, char* out) const {
+
+  // Valid fields, the common case, cost a single SIMD pass
+  if (Utf8Policy::kAccept == _utf8_policy || IsValidUtf8 (field)) {
+
+    out = this->WriteEscaped (field, out);
+
+  } else {
+
+    out += this->EscapeInvalidUtf8 (field, out);
+
+  }
+
+  return out;
+
+}
+
+/**
+ * @brief Count the escaped size of bytes, without UTF-8 validation
+ */
+size_t DelimitedSerializer::CountEscaped (std::string_view field) const {
+
+  size_t size = 0;
 
   for (char c : field) {
 
-    switch (c) {
+    size += _escaped_lengths[static_cast<unsigned char> (c)];
+
+  }
 
-      case '\\':
+  return size;
 
-        escaped += "\\\\";
-        break;
+}
 
-      case '\n':
+/**
+ * @brief Escape bytes without UTF-8 validation
+ */
+char* DelimitedSerializer::WriteEscaped (std::string_view field, char* out) const {
 
-        escaped += "\\n";
-        break;
+  const char* data = field.data ();
 
-      case '\r':
+  // Start of the run of bytes copied verbatim
+  size_t run = 0;
 
-        break;
+  for (size_t i = 0; i < field.length (); ++i) {
 
-      default:
+    const uint8_t length = _escaped_lengths[static_cast<unsigned char> (data[i])];
 
-        if (c == _delimiter) {
+    if (kByteCopied != length) {
 
-          escaped += '\\';
-          escaped += c;
+      std::memcpy (out, data + run, i - run);
+      out += i - run;
+      run = i + 1;
 
-        } else {
+      if (kByteEscaped == length) {
 
-          escaped += c;
+        *out++ = '\\';
+        *out++ = '\n' == data[i] ? 'n' : data[i];
 
-        }
+      }
 
     }
 
   }
 
-  return escaped;
+  std::memcpy (out, data + run, field.length () - run);
+
+  return out + field.length () - run;
+
+}
+
+/**
+ * @brief Escape a field holding malformed UTF-8 according to the policy
+ */
+size_t DelimitedSerializer::EscapeInvalidUtf8 (std::string_view field,
+                                               char* out) const {
+
+  size_t size = 0;
+
+  // Counts a piece and, when there is an output, writes it
+  auto piece = [this, &size, &out] (std::string_view bytes) {
+
+    size += this->CountEscaped (bytes);
+
+    if (nullptr != out) { out = this->WriteEscaped (bytes, out); }
+
+  };
+
+  size_t position = 0;
+  Utf8Error error = FindInvalidUtf8 (field);
+
+  while (std::string_view::npos != error.position) {
+
+    piece (field.substr (position, error.position - position));
+
+    if (Utf8Policy::kReject == _utf8_policy) {
+
+      throw serializer_error ("Invalid UTF-8 at byte " +
+                              std::to_string (error.position) + " of a field.");
+
+    } else if (Utf8Policy::kReplace == _utf8_policy) {
+
+      // The replacement may start like the delimiter, escape it too
+      piece (kReplacementCharacter);
+
+    } else {
+
+      for (size_t i = error.position; i < error.position + error.length; ++i) {
+
+        const unsigned char byte = static_cast<unsigned char> (field[i]);
+        const char escape[kByteEscapeLength] = {'\\', kByteEscape[0],
+                                                kHexDigits[byte >> 4],
+                                                kHexDigits[byte & 0xF]};
+
+        // The backslash is the escape itself, the rest as any other bytes
+        size += 1;
+        if (nullptr != out) { *out++ = escape[0]; }
+        piece (std::string_view (escape + 1, kByteEscapeLength - 1));
+
+      }
+
+    }
+
+    position = error.position + error.length;
+    error = FindInvalidUtf8 (field, position);
+
+  }
+
+  piece (field.substr (position));
+
+  return size;
+
+}
+
+/**
+ * @brief Deserialize the fields of a serialized line
+ */
+void DelimitedSerializer::DeserializeFields (std::string_view line,
+                                             std::string& deserialized,
+                                             uint32_t* crc) const {
+
+  const char first = _delimiter[0];
+
+  // Start of the bytes not yet added to the checksum
+  size_t crc_start = 0;
+
+  for (size_t i = 0; i < line.length (); ++i) {
+
+    if (line[i] == '\\' && i + 1 < line.length ()) {
+
+      // Handle escaped characters
+      char next = line[i + 1];
+      if (next == '\\') {
+
+        deserialized += '\\';
+        ++i; // Skip next character
+
+      } else if (next == 'n') {
+
+        deserialized += '\n';
+        ++i; // Skip next character
+
+      } else if (next == first) {
+
+        deserialized += first;
+        ++i; // Skip next character
+
+      } else {
+
+        // Unknown escape sequence, treat as literal
+        deserialized += line[i];
+
+      }
+
+    } else if (line[i] == first &&
+               0 == line.compare (i, _delimiter.length (), _delimiter)) {
+
+      // Found unescaped delimiter, end current field
+      deserialized += '\n';
+      i += _delimiter.length () - 1; // Skip the rest of the delimiter
+
+      if (nullptr != crc) {
+
+        *crc = Crc32c (line.data () + crc_start, i + 1 - crc_start, *crc);
+        crc_start = i + 1;
+
+      }
+
+    } else {
+
+      deserialized += line[i];
+
+    }
+
+  }
+
+  // End the last field
+  deserialized += '\n';
+
+  if (nullptr != crc) {
+
+    *crc = Crc32c (line.data () + crc_start, line.length () - crc_start, *crc);
+
+  }
 
 }
 
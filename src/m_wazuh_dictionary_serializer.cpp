@@ -0,0 +1,273 @@
+/*******************************************************************************
+ * @file m_wazuh_dictionary_serializer.cpp
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-05
+ * @version 1.1.0
+ * @changelog
+ * - v1.0.0: Initial implementation
+ * - v1.1.0: Multi byte delimiters
+ * @brief Dictionary Serializer implementation
+ *
+ * @details
+ * This file contains the implementation of the WAZUH::DictionarySerializer
+ * class. Both sides work on delimited records, one per line, and keep a
+ * single dictionary for the whole stream. Fields are handled in their
+ * escaped form, so they are copied or referenced without being unescaped.
+ * Every literal field long enough to be worth a reference is added to the
+ * dictionary on both sides; a reference hit refreshes old entries.
+ */
+
+
+/******************************************************************************
+ * Cpp Includes
+ */
+#include "m_wazuh_dictionary_serializer.h"
+#include "m_wazuh_field_dictionary.h"
+
+#include <charconv>
+#include <limits>
+#include <string_view>
+
+
+/******************************************************************************
+ * C includes
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+ * Namespace declaration
+ */
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+constexpr char kReferencePrefix[] = "\\*";
+constexpr size_t kReferencePrefixLength = sizeof (kReferencePrefix) - 1;
+
+// Shorter values always cost less written in full than as a reference
+constexpr size_t kMinEntryLength = 4;
+
+
+/******************************************************************************
+ * Implementation of public functions / methods
+ */
+
+/**
+ * @brief Constructor with delimiter and dictionary size
+ */
+DictionarySerializer::DictionarySerializer (const std::string& delimiter,
+                                            size_t capacity) :
+  _delimited {delimiter},
+  _capacity {capacity} {
+
+  // The first byte is the one escaped inside fields
+  if ('*' == delimiter[0]) {
+
+    throw serializer_error ("Delimiter starting with '*' is reserved by the "
+                            "dictionary format.");
+
+  }
+
+}
+
+/**
+ * @brief Serialize method
+ */
+std::string DictionarySerializer::Serialize (std::istream& input) const {
+
+  FieldDictionary dictionary (this->_capacity);
+  std::string serialized;
+  std::string line;
+  bool first = true;
+
+  // One dictionary for the whole stream, so values repeated by later
+  // records are referenced too
+  while (std::getline (input, line)) {
+
+    if (!first) { serialized += '\n'; }
+    else { first = false; }
+
+    this->EncodeRecord (line, dictionary, serialized);
+
+  }
+
+  return serialized;
+
+}
+
+/**
+ * @brief Deserialize method
+ */
+std::string DictionarySerializer::Deserialize (std::istream& input) const {
+
+  FieldDictionary dictionary (this->_capacity);
+  std::string deserialized;
+  std::string line;
+
+  while (std::getline (input, line)) {
+
+    this->DecodeRecord (line, dictionary, deserialized);
+
+  }
+
+  return deserialized;
+
+}
+
+
+/******************************************************************************
+ * Implementation of protected functions / methods
+ */
+
+
+/******************************************************************************
+ * Implementation of private functions / methods
+ */
+
+/**
+ * @brief Encode the fields of a delimited record
+ */
+void DictionarySerializer::EncodeRecord (std::string_view line,
+                                         FieldDictionary& dictionary,
+                                         std::string& serialized) const {
+
+  char digits[std::numeric_limits<size_t>::digits10 + 1];
+  size_t start = 0;
+
+  for (;;) {
+
+    size_t end = this->_delimited.FindDelimiter (line, start);
+    if (std::string_view::npos == end) { end = line.length (); }
+
+    std::string_view raw = line.substr (start, end - start);
+
+    if (0 == raw.compare (0, kReferencePrefixLength, kReferencePrefix)) {
+
+      throw serializer_error ("Field starting with '" + std::string (kReferencePrefix) +
+                              "' is reserved by the dictionary format.");
+
+    }
+
+    if (0 != start) { serialized += this->_delimited.Delimiter (); }
+
+    size_t slot = 0;
+    bool referenced = false;
+
+    if (raw.length () >= kMinEntryLength && dictionary.Find (raw, slot)) {
+
+      const size_t length = static_cast<size_t> (
+        std::to_chars (digits, digits + sizeof (digits), slot).ptr - digits);
+
+      if (kReferencePrefixLength + length < raw.length ()) {
+
+        serialized.append (kReferencePrefix, kReferencePrefixLength);
+        serialized.append (digits, length);
+        dictionary.Refresh (slot);
+        referenced = true;
+
+      }
+
+    }
+
+    if (!referenced) {
+
+      serialized += raw;
+
+      if (raw.length () >= kMinEntryLength) {
+
+        dictionary.Insert (raw);
+
+      }
+
+    }
+
+    if (end == line.length ()) { break; }
+
+    start = end + this->_delimited.Delimiter ().length ();
+
+  }
+
+}
+
+/**
+ * @brief Decode an encoded record back to a delimited record
+ */
+void DictionarySerializer::DecodeRecord (std::string_view line,
+                                         FieldDictionary& dictionary,
+                                         std::string& deserialized) const {
+
+  size_t start = 0;
+
+  for (;;) {
+
+    size_t end = this->_delimited.FindDelimiter (line, start);
+    if (std::string_view::npos == end) { end = line.length (); }
+
+    std::string_view raw = line.substr (start, end - start);
+
+    if (0 != start) { deserialized += this->_delimited.Delimiter (); }
+
+    if (0 == raw.compare (0, kReferencePrefixLength, kReferencePrefix)) {
+
+      std::string_view digits = raw.substr (kReferencePrefixLength);
+      size_t slot = 0;
+
+      if (digits.empty () ||
+          std::string_view::npos != digits.find_first_not_of ("0123456789")) {
+
+        throw serializer_error ("Malformed dictionary reference '" +
+                                std::string (raw) + "'.");
+
+      }
+
+      for (char digit : digits) {
+
+        slot = slot * 10 + static_cast<size_t> (digit - '0');
+        if (slot >= this->_capacity) { break; }
+
+      }
+
+      if (!dictionary.IsValid (slot)) {
+
+        throw serializer_error ("Unknown dictionary reference '" +
+                                std::string (raw) + "'.");
+
+      }
+
+      deserialized += dictionary.At (slot);
+      dictionary.Refresh (slot);
+
+    } else {
+
+      deserialized += raw;
+
+      if (raw.length () >= kMinEntryLength) {
+
+        dictionary.Insert (raw);
+
+      }
+
+    }
+
+    if (end == line.length ()) { break; }
+
+    start = end + this->_delimited.Delimiter ().length ();
+
+  }
+
+  deserialized += '\n';
+
+}
+
+} /* namespace WAZUH */
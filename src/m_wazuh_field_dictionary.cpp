@@ -0,0 +1,274 @@
+/*******************************************************************************
+ * @file m_wazuh_field_dictionary.cpp
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-05
+ * @version 1.0.0
+ * @changelog
+ * - v1.0.0: Initial implementation
+ * @brief Field Dictionary implementation
+ *
+ * @details
+ * This file contains the implementation of the WAZUH::FieldDictionary class.
+ * The hash table is a flat array of 8 byte buckets probed linearly and kept
+ * at most half full. Removals use backward shift deletion, so lookups never
+ * have to skip tombstones.
+ */
+
+
+/******************************************************************************
+ * Cpp Includes
+ */
+#include "m_wazuh_field_dictionary.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+/******************************************************************************
+ * C includes
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+ * Namespace declaration
+ */
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+constexpr uint32_t kEmptySlot = UINT32_MAX;
+constexpr uint64_t kHashSeed = 0x9E3779B97F4A7C15ULL;
+constexpr uint64_t kHashMultiplier = 0xFF51AFD7ED558CCDULL;
+
+
+/******************************************************************************
+ * Implementation of public functions / methods
+ */
+
+/**
+ * @brief Constructor with the number of slots
+ */
+FieldDictionary::FieldDictionary (size_t capacity) :
+  _mask {0},
+  _next {0} {
+
+  capacity = std::max<size_t> (capacity, 1);
+
+  size_t bucket_count = 1;
+  while (bucket_count < 2 * capacity) { bucket_count <<= 1; }
+
+  this->_values.resize (capacity);
+  this->_hashes.resize (capacity);
+  this->_used.resize (capacity, false);
+  this->_buckets.resize (bucket_count, {0, kEmptySlot});
+  this->_mask = bucket_count - 1;
+
+}
+
+/**
+ * @brief Look up the most recent slot holding a value
+ */
+bool FieldDictionary::Find (std::string_view value, size_t& slot) const {
+
+  const uint32_t hash = Hash (value);
+
+  for (size_t i = hash & this->_mask;
+       kEmptySlot != this->_buckets[i].slot;
+       i = (i + 1) & this->_mask) {
+
+    const Bucket& bucket = this->_buckets[i];
+
+    if (bucket.hash == hash && this->_values[bucket.slot] == value) {
+
+      slot = bucket.slot;
+      return true;
+
+    }
+
+  }
+
+  return false;
+
+}
+
+/**
+ * @brief Store a value in the next slot, evicting the oldest one
+ */
+size_t FieldDictionary::Insert (std::string_view value) {
+
+  const size_t slot = this->_next;
+  const uint32_t hash = Hash (value);
+
+  if (this->_used[slot]) {
+
+    this->Unlink (slot);
+
+  }
+
+  this->_values[slot].assign (value.data (), value.length ());
+  this->_hashes[slot] = hash;
+  this->_used[slot] = true;
+
+  size_t i = hash & this->_mask;
+
+  for (; kEmptySlot != this->_buckets[i].slot; i = (i + 1) & this->_mask) {
+
+    Bucket& bucket = this->_buckets[i];
+
+    // An older copy of the value now resolves to the newest slot
+    if (bucket.hash == hash && this->_values[bucket.slot] == value) {
+      break;
+    }
+
+  }
+
+  this->_buckets[i] = {hash, static_cast<uint32_t> (slot)};
+  this->_next = (this->_next + 1) % this->_values.size ();
+
+  return slot;
+
+}
+
+/**
+ * @brief Move the value of an old slot to the newest position
+ */
+void FieldDictionary::Refresh (size_t slot) {
+
+  const size_t capacity = this->_values.size ();
+  const size_t age = (this->_next + capacity - slot - 1) % capacity;
+
+  if (age < capacity / 2) { return; }
+
+  if (slot == this->_next) {
+
+    // The oldest slot becomes the newest one without moving the value
+    this->_next = (this->_next + 1) % capacity;
+
+  } else {
+
+    this->Insert (this->_values[slot]);
+
+  }
+
+}
+
+/**
+ * @brief Check whether a slot holds a value
+ */
+bool FieldDictionary::IsValid (size_t slot) const {
+
+  return slot < this->_values.size () && this->_used[slot];
+
+}
+
+/**
+ * @brief Get the value of a slot
+ */
+std::string_view FieldDictionary::At (size_t slot) const {
+
+  return this->_values[slot];
+
+}
+
+/**
+ * @brief Remove every value
+ */
+void FieldDictionary::Clear (void) {
+
+  std::fill (this->_used.begin (), this->_used.end (), false);
+  std::fill (this->_buckets.begin (), this->_buckets.end (),
+             Bucket {0, kEmptySlot});
+  this->_next = 0;
+
+}
+
+
+/******************************************************************************
+ * Implementation of protected functions / methods
+ */
+
+
+/******************************************************************************
+ * Implementation of private functions / methods
+ */
+
+/**
+ * @brief Hash a value, eight bytes at a time
+ */
+uint32_t FieldDictionary::Hash (std::string_view value) {
+
+  const char* data = value.data ();
+  size_t length = value.length ();
+  uint64_t hash = kHashSeed ^ length;
+  uint64_t word = 0;
+
+  while (length >= sizeof (word)) {
+
+    std::memcpy (&word, data, sizeof (word));
+    hash = (hash ^ word) * kHashMultiplier;
+    hash ^= hash >> 32;
+
+    data += sizeof (word);
+    length -= sizeof (word);
+
+  }
+
+  word = 0;
+  std::memcpy (&word, data, length);
+  hash = (hash ^ word) * kHashMultiplier;
+  hash ^= hash >> 29;
+
+  return static_cast<uint32_t> (hash);
+
+}
+
+/**
+ * @brief Remove the table entry pointing at a slot, if any
+ */
+void FieldDictionary::Unlink (size_t slot) {
+
+  size_t hole = this->_hashes[slot] & this->_mask;
+
+  // Entries are only present while they map the newest copy of a value
+  while (this->_buckets[hole].slot != slot) {
+
+    if (kEmptySlot == this->_buckets[hole].slot) { return; }
+    hole = (hole + 1) & this->_mask;
+
+  }
+
+  // Backward shift: pull later entries of the cluster into the hole unless
+  // that would move them before their home bucket
+  for (size_t i = (hole + 1) & this->_mask;
+       kEmptySlot != this->_buckets[i].slot;
+       i = (i + 1) & this->_mask) {
+
+    const size_t home = this->_buckets[i].hash & this->_mask;
+    const bool in_place = (hole <= i) ? (hole < home && home <= i)
+                                      : (hole < home || home <= i);
+
+    if (!in_place) {
+
+      this->_buckets[hole] = this->_buckets[i];
+      hole = i;
+
+    }
+
+  }
+
+  this->_buckets[hole].slot = kEmptySlot;
+
+}
+
+} /* namespace WAZUH */
@@ -0,0 +1,426 @@
+/*******************************************************************************
+ * @file m_wazuh_json_transcoder.cpp
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-09
+ * @version 1.0.0
+ * @changelog
+ * - v1.0.0: Initial implementation
+ * @brief JSON Transcoder implementation
+ *
+ * @details
+ * This file contains the implementation of the WAZUH::JsonTranscoder class.
+ * A serialized field only needs attention at backslashes, quotes, control
+ * characters and the first byte of the delimiter; everything in between is
+ * copied to the JSON string as it is. The checksum is extended field by
+ * field during the same scan.
+ */
+
+
+/******************************************************************************
+ * Cpp Includes
+ */
+#include "m_wazuh_json_transcoder.h"
+#include "m_wazuh_crc32c.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+
+/******************************************************************************
+ * C includes
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+ * Namespace declaration
+ */
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+constexpr size_t kTranscodeBlockSize = 1 << 20;
+
+constexpr unsigned char kLastControl = 0x1F;
+constexpr char kHexDigits[] = "0123456789abcdef";
+
+#ifdef __SSE2__
+constexpr size_t kBlockSize = sizeof (__m128i);
+#endif
+
+
+/******************************************************************************
+ * Local functions
+ */
+
+/**
+ * @brief Find the first byte that is not copied verbatim
+ * @return Offset of a backslash, quote, control character or delimiter
+ *         first byte, or length if there is none
+ */
+static size_t FindSpecial (const char* data, size_t length, char delimiter) {
+
+  size_t i = 0;
+
+#ifdef __SSE2__
+  const __m128i backslash = _mm_set1_epi8 ('\\');
+  const __m128i quote = _mm_set1_epi8 ('"');
+  const __m128i first = _mm_set1_epi8 (delimiter);
+  const __m128i control = _mm_set1_epi8 (kLastControl);
+
+  for (; i + kBlockSize <= length; i += kBlockSize) {
+
+    const __m128i block = _mm_loadu_si128 (
+      reinterpret_cast<const __m128i*> (data + i));
+
+    // Unsigned c <= 0x1F is the same as max (c, 0x1F) == 0x1F
+    const __m128i special = _mm_or_si128 (
+      _mm_or_si128 (_mm_cmpeq_epi8 (block, backslash),
+                    _mm_cmpeq_epi8 (block, quote)),
+      _mm_or_si128 (_mm_cmpeq_epi8 (block, first),
+                    _mm_cmpeq_epi8 (_mm_max_epu8 (block, control), control)));
+
+    const unsigned mask = static_cast<unsigned> (_mm_movemask_epi8 (special));
+
+    if (0 != mask) { return i + __builtin_ctz (mask); }
+
+  }
+#endif
+
+  for (; i < length; ++i) {
+
+    const unsigned char c = static_cast<unsigned char> (data[i]);
+
+    if ('\\' == c || '"' == c || c <= kLastControl || delimiter == data[i]) {
+
+      return i;
+
+    }
+
+  }
+
+  return length;
+
+}
+
+/**
+ * @brief Append a raw byte to a JSON string, escaping it if required
+ */
+static void AppendJsonByte (std::string& json, char c) {
+
+  switch (c) {
+
+    case '"':  json += "\\\""; break;
+    case '\\': json += "\\\\"; break;
+    case '\b': json += "\\b"; break;
+    case '\f': json += "\\f"; break;
+    case '\n': json += "\\n"; break;
+    case '\r': json += "\\r"; break;
+    case '\t': json += "\\t"; break;
+
+    default:
+
+      if (static_cast<unsigned char> (c) <= kLastControl) {
+
+        json += "\\u00";
+        json += kHexDigits[(c >> 4) & 0xF];
+        json += kHexDigits[c & 0xF];
+
+      } else {
+
+        json += c;
+
+      }
+
+  }
+
+}
+
+
+/******************************************************************************
+ * Implementation of public functions / methods
+ */
+
+/**
+ * @brief Constructor with the serializer of the records
+ */
+JsonTranscoder::JsonTranscoder (const DelimitedSerializer& serializer) :
+  _serializer {serializer} {
+
+}
+
+/**
+ * @brief Set the names of the columns, to write objects
+ */
+void JsonTranscoder::SetColumns (const std::string& spec) {
+
+  std::vector<std::string> keys;
+  std::unordered_set<std::string_view> names;
+
+  if (spec.empty ()) { this->_keys.clear (); return; }
+
+  size_t start = 0;
+
+  for (;;) {
+
+    size_t end = spec.find (',', start);
+    if (std::string::npos == end) { end = spec.length (); }
+
+    std::string_view name = std::string_view (spec).substr (start, end - start);
+
+    // Unnamed fields are keyed by their position, a number
+    if (!name.empty () &&
+        std::string_view::npos == name.find_first_not_of ("0123456789")) {
+
+      throw serializer_error ("Column name '" + std::string (name) +
+                              "' is numeric, reserved for unnamed fields.");
+
+    }
+
+    if (!name.empty () && !names.insert (name).second) {
+
+      throw serializer_error ("Duplicate column name '" + std::string (name) + "'.");
+
+    }
+
+    // An empty name, as in "a,,c", leaves its field unnamed
+    std::string key = "\"";
+
+    if (name.empty ()) {
+
+      key += std::to_string (keys.size ());
+
+    } else {
+
+      for (char c : name) { AppendJsonByte (key, c); }
+
+    }
+
+    key += "\":\"";
+
+    keys.push_back (std::move (key));
+
+    if (end == spec.length ()) { break; }
+    start = end + 1;
+
+  }
+
+  this->_keys = std::move (keys);
+
+}
+
+/**
+ * @brief Transcode a stream of records
+ */
+void JsonTranscoder::Transcode (std::istream& input,
+                                std::ostream& output) const {
+
+  std::string buffer;
+  std::string json;
+  bool end_of_input = false;
+
+  while (!end_of_input) {
+
+    const size_t kept = buffer.length ();
+    buffer.resize (kept + kTranscodeBlockSize);
+    input.read (&buffer[kept], kTranscodeBlockSize);
+    buffer.resize (kept + static_cast<size_t> (input.gcount ()));
+    end_of_input = !input;
+
+    std::string_view block (buffer);
+    size_t processed = 0;
+
+    json.clear ();
+
+    try {
+
+      for (;;) {
+
+        size_t line_end = block.find ('\n', processed);
+
+        if (std::string_view::npos == line_end) {
+
+          // A last line without new line is still a record
+          if (!end_of_input || processed >= block.length ()) { break; }
+          line_end = block.length ();
+
+        }
+
+        this->TranscodeRecord (block.substr (processed, line_end - processed),
+                               json);
+        processed = line_end + 1;
+
+      }
+
+    } catch (const serializer_error&) {
+
+      // Records before the corrupted one are valid, do not lose them
+      output.write (json.data (), json.length ());
+      throw;
+
+    }
+
+    output.write (json.data (), json.length ());
+    buffer.erase (0, std::min (processed, buffer.length ()));
+
+  }
+
+  output.flush ();
+
+}
+
+/**
+ * @brief Transcode a single record
+ */
+void JsonTranscoder::TranscodeRecord (std::string_view line,
+                                      std::string& json) const {
+
+  std::string_view payload = line;
+  const bool checksum = this->_serializer.HasChecksum ();
+  uint32_t expected = 0;
+  uint32_t crc = 0;
+
+  if (checksum) {
+
+    payload = this->_serializer.SplitChecksum (line, expected);
+
+  }
+
+  const std::string& delimiter = this->_serializer.Delimiter ();
+  const char* data = payload.data ();
+  const size_t length = payload.length ();
+  const size_t json_start = json.length ();
+  size_t field = 0;
+  size_t i = 0;
+
+  // Start of the bytes not yet added to the checksum
+  size_t crc_start = 0;
+
+  json += this->_keys.empty () ? '[' : '{';
+  this->OpenField (field, json);
+
+  for (;;) {
+
+    const size_t special = i + FindSpecial (data + i, length - i,
+                                            delimiter[0]);
+
+    json.append (data + i, special - i);
+    if (special == length) { break; }
+
+    const char c = data[special];
+    i = special + 1;
+
+    if ('\\' == c) {
+
+      // A trailing backslash is a literal
+      const char next = i < length ? data[i] : '\0';
+
+      if (i == length) {
+
+        json += "\\\\";
+
+      } else if ('\\' == next || delimiter[0] == next) {
+
+        AppendJsonByte (json, next);
+        ++i; // Skip next character
+
+      } else if ('n' == next) {
+
+        json += "\\n";
+        ++i; // Skip next character
+
+      } else {
+
+        // Unknown escape sequence, the backslash is a literal
+        json += "\\\\";
+
+      }
+
+    } else if (delimiter[0] == c &&
+               0 == payload.compare (special, delimiter.length (), delimiter)) {
+
+      // Found unescaped delimiter, close the field and open the next one
+      json += "\",";
+      this->OpenField (++field, json);
+      i = special + delimiter.length ();
+
+      if (checksum) {
+
+        crc = Crc32c (data + crc_start, i - crc_start, crc);
+        crc_start = i;
+
+      }
+
+    } else {
+
+      AppendJsonByte (json, c);
+
+    }
+
+  }
+
+  if (checksum) {
+
+    crc = Crc32c (data + crc_start, length - crc_start, crc);
+
+    if (crc != expected) {
+
+      json.resize (json_start);
+      throw serializer_error ("Checksum mismatch, the record is corrupted.");
+
+    }
+
+  }
+
+  json += '"';
+  json += this->_keys.empty () ? ']' : '}';
+  json += '\n';
+
+}
+
+
+/******************************************************************************
+ * Implementation of protected functions / methods
+ */
+
+
+/******************************************************************************
+ * Implementation of private functions / methods
+ */
+
+/**
+ * @brief Open the JSON string of a field
+ */
+void JsonTranscoder::OpenField (size_t field, std::string& json) const {
+
+  if (this->_keys.empty ()) {
+
+    json += '"';
+
+  } else if (field < this->_keys.size ()) {
+
+    json += this->_keys[field];
+
+  } else {
+
+    json += '"';
+    json += std::to_string (field);
+    json += "\":\"";
+
+  }
+
+}
+
+} /* namespace WAZUH */
@@ -0,0 +1,273 @@
+/*******************************************************************************
+ * @file m_wazuh_lazy_record.cpp
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-09
+ * @version 1.0.0
+ * @changelog
+ * - v1.0.0: Initial implementation
+ * @brief Lazy Record implementation
+ *
+ * @details
+ * This file contains the implementation of the WAZUH::LazyRecord class.
+ * The boundary scan looks for backslashes and the first byte of the
+ * delimiter at once, 16 bytes at a time with SSE2, so a field is read a
+ * single time to find its end and whether it needs unescaping.
+ */
+
+
+/******************************************************************************
+ * Cpp Includes
+ */
+#include "m_wazuh_lazy_record.h"
+#include "m_wazuh_crc32c.h"
+
+#include <algorithm>
+
+
+/******************************************************************************
+ * C includes
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+ * Namespace declaration
+ */
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+#ifdef __SSE2__
+constexpr size_t kBlockSize = sizeof (__m128i);
+#endif
+
+
+/******************************************************************************
+ * Local functions
+ */
+
+/**
+ * @brief Find the first backslash or delimiter first byte
+ * @return Offset of the byte, or length if there is none
+ */
+static size_t FindBoundary (const char* data, size_t length, char delimiter) {
+
+  size_t i = 0;
+
+#ifdef __SSE2__
+  const __m128i backslash = _mm_set1_epi8 ('\\');
+  const __m128i first = _mm_set1_epi8 (delimiter);
+
+  for (; i + kBlockSize <= length; i += kBlockSize) {
+
+    const __m128i block = _mm_loadu_si128 (
+      reinterpret_cast<const __m128i*> (data + i));
+
+    const unsigned mask = static_cast<unsigned> (_mm_movemask_epi8 (
+      _mm_or_si128 (_mm_cmpeq_epi8 (block, backslash),
+                    _mm_cmpeq_epi8 (block, first))));
+
+    if (0 != mask) { return i + __builtin_ctz (mask); }
+
+  }
+#endif
+
+  for (; i < length; ++i) {
+
+    if ('\\' == data[i] || delimiter == data[i]) { return i; }
+
+  }
+
+  return length;
+
+}
+
+
+/******************************************************************************
+ * Implementation of public functions / methods
+ */
+
+/**
+ * @brief Constructor over a serialized line
+ */
+LazyRecord::LazyRecord (const DelimitedSerializer& serializer,
+                        std::string_view line) :
+  _serializer {serializer} {
+
+  this->Reset (line);
+
+}
+
+/**
+ * @brief Constructor without a line, for a record filled with Reset
+ */
+LazyRecord::LazyRecord (const DelimitedSerializer& serializer) :
+  _serializer {serializer} {
+
+}
+
+/**
+ * @brief Scan another serialized line, dropping the previous one
+ */
+void LazyRecord::Reset (std::string_view line) {
+
+  const bool checksum = this->_serializer.HasChecksum ();
+  uint32_t expected = 0;
+  uint32_t crc = 0;
+
+  this->_fields.clear ();
+  this->_values.clear ();
+  this->_line = line;
+
+  if (checksum) {
+
+    this->_line = this->_serializer.SplitChecksum (line, expected);
+
+  }
+
+  // No-op once the capacity fits the lines
+  this->_values.reserve (this->_line.length ());
+
+  const std::string& delimiter = this->_serializer.Delimiter ();
+  const char* data = this->_line.data ();
+  const size_t length = this->_line.length ();
+  FieldSpan field {0, 0, false, kNotUnescaped, 0};
+  size_t i = 0;
+
+  for (;;) {
+
+    const size_t boundary = i + FindBoundary (data + i, length - i,
+                                              delimiter[0]);
+
+    if (boundary == length) { break; }
+
+    if ('\\' == data[boundary]) {
+
+      // The escaped byte is never a boundary, skip it
+      field.escaped = true;
+      i = std::min (boundary + 2, length);
+
+    } else if (0 == this->_line.compare (boundary, delimiter.length (),
+                                         delimiter)) {
+
+      field.length = boundary - field.offset;
+      this->_fields.push_back (field);
+
+      i = boundary + delimiter.length ();
+
+      // The field and its delimiter, still in cache from the scan
+      if (checksum) {
+
+        crc = Crc32c (data + field.offset, i - field.offset, crc);
+
+      }
+
+      field.offset = i;
+      field.escaped = false;
+
+    } else {
+
+      // First byte of a multi byte delimiter, not followed by the rest
+      i = boundary + 1;
+
+    }
+
+  }
+
+  field.length = length - field.offset;
+  this->_fields.push_back (field);
+
+  if (checksum) {
+
+    crc = Crc32c (data + field.offset, field.length, crc);
+
+    if (crc != expected) {
+
+      this->_fields.clear ();
+      this->_line = std::string_view ();
+      throw serializer_error ("Checksum mismatch, the record is corrupted.");
+
+    }
+
+  }
+
+}
+
+/**
+ * @brief Get the number of fields
+ */
+size_t LazyRecord::FieldCount (void) const {
+
+  return this->_fields.size ();
+
+}
+
+/**
+ * @brief Check whether a field holds escape sequences
+ */
+bool LazyRecord::NeedsUnescape (size_t field) const {
+
+  return this->_fields.at (field).escaped;
+
+}
+
+/**
+ * @brief Get the serialized bytes of a field, to forward it as it is
+ */
+std::string_view LazyRecord::Raw (size_t field) const {
+
+  const FieldSpan& span = this->_fields.at (field);
+
+  return this->_line.substr (span.offset, span.length);
+
+}
+
+/**
+ * @brief Get the value of a field, unescaping it on first access
+ */
+std::string_view LazyRecord::Value (size_t field) {
+
+  FieldSpan& span = this->_fields.at (field);
+
+  if (!span.escaped) {
+
+    return this->_line.substr (span.offset, span.length);
+
+  }
+
+  if (kNotUnescaped == span.value) {
+
+    span.value = this->_values.length ();
+    this->_serializer.UnescapeField (
+      this->_line.substr (span.offset, span.length), this->_values);
+    span.value_length = this->_values.length () - span.value;
+
+  }
+
+  return std::string_view (this->_values).substr (span.value, span.value_length);
+
+}
+
+
+/******************************************************************************
+ * Implementation of protected functions / methods
+ */
+
+
+/******************************************************************************
+ * Implementation of private functions / methods
+ */
+
+} /* namespace WAZUH */
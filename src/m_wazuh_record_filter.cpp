@@ -0,0 +1,299 @@
+/*******************************************************************************
+ * @file m_wazuh_record_filter.cpp
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-08
+ * @version 1.1.0
+ * @changelog
+ * - v1.0.0: Initial implementation
+ * - v1.1.0: Multi byte delimiters
+ * @brief Record Filter implementation
+ *
+ * @details
+ * This file contains the implementation of the WAZUH::RecordFilter class.
+ * Escaping is a token by token mapping, so on canonical fields equality and
+ * prefix tests on escaped bytes are exact. A substring match is only valid
+ * if it starts on a token boundary, which holds when an even number of
+ * backslashes precede it.
+ */
+
+
+/******************************************************************************
+ * Cpp Includes
+ */
+#include "m_wazuh_record_filter.h"
+#include "m_wazuh_simd_search.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+/******************************************************************************
+ * C includes
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+ * Namespace declaration
+ */
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+constexpr char kPredicateSeparator[] = "&&";
+constexpr char kPredicateOperators[] = "=^~";
+constexpr size_t kMaxFieldDigits = 9;
+
+
+/******************************************************************************
+ * Implementation of public functions / methods
+ */
+
+/**
+ * @brief Constructor with the serializer of the records
+ */
+RecordFilter::RecordFilter (const DelimitedSerializer& serializer) :
+  _serializer {serializer} {
+
+}
+
+/**
+ * @brief Add predicates from their text form
+ */
+void RecordFilter::AddPredicates (const std::string& spec) {
+
+  size_t start = 0;
+
+  while (start <= spec.length ()) {
+
+    size_t end = spec.find (kPredicateSeparator, start);
+    if (std::string::npos == end) { end = spec.length (); }
+
+    std::string predicate = spec.substr (start, end - start);
+    size_t op = predicate.find_first_of (kPredicateOperators);
+
+    // The field index is a run of digits right before the operator
+    if (std::string::npos == op || 0 == op || op > kMaxFieldDigits ||
+        op != predicate.find_first_not_of ("0123456789")) {
+
+      throw filter_error ("Malformed predicate '" + predicate + "'.");
+
+    }
+
+    PredicateType type = PredicateType::kEquals;
+    if ('^' == predicate[op]) { type = PredicateType::kPrefix; }
+    else if ('~' == predicate[op]) { type = PredicateType::kContains; }
+
+    this->AddPredicate (std::stoul (predicate.substr (0, op)), type,
+                        predicate.substr (op + 1));
+
+    start = end + sizeof (kPredicateSeparator) - 1;
+
+  }
+
+}
+
+/**
+ * @brief Add a predicate
+ */
+void RecordFilter::AddPredicate (size_t field, PredicateType type,
+                                 std::string value) {
+
+  FieldPredicate predicate;
+  predicate.field = field;
+  predicate.type = type;
+  predicate.value = std::move (value);
+  // Records are matched as serialized, whatever policy wrote them
+  this->_serializer.EscapeLiteral (predicate.value, predicate.escaped);
+
+  // Keep predicates in field order, so a record is scanned only once
+  auto position = std::upper_bound (
+    this->_predicates.begin (), this->_predicates.end (), field,
+    [] (size_t index, const FieldPredicate& other) {
+      return index < other.field;
+    });
+
+  this->_predicates.insert (position, std::move (predicate));
+
+}
+
+/**
+ * @brief Check whether a serialized record matches every predicate
+ */
+bool RecordFilter::Matches (std::string_view line) const {
+
+  const size_t delimiter_length = this->_serializer.Delimiter ().length ();
+  auto predicate = this->_predicates.begin ();
+  size_t field = 0;
+  size_t start = 0;
+
+  while (predicate != this->_predicates.end ()) {
+
+    size_t end = this->_serializer.FindDelimiter (line, start);
+    if (std::string_view::npos == end) { end = line.length (); }
+
+    for (; predicate != this->_predicates.end () && predicate->field == field;
+         ++predicate) {
+
+      if (!this->Evaluate (*predicate, line.substr (start, end - start))) {
+
+        return false;
+
+      }
+
+    }
+
+    // The record does not have the fields still to be checked
+    if (end == line.length () && predicate != this->_predicates.end ()) {
+
+      return false;
+
+    }
+
+    start = end + delimiter_length;
+    ++field;
+
+  }
+
+  return true;
+
+}
+
+/**
+ * @brief Check whether the filter has no predicates
+ */
+bool RecordFilter::Empty (void) const {
+
+  return this->_predicates.empty ();
+
+}
+
+
+/******************************************************************************
+ * Implementation of protected functions / methods
+ */
+
+
+/******************************************************************************
+ * Implementation of private functions / methods
+ */
+
+/**
+ * @brief Evaluate a predicate on a serialized field
+ */
+bool RecordFilter::Evaluate (const FieldPredicate& predicate,
+                             std::string_view field) const {
+
+  bool matches = false;
+
+  if (this->IsCanonical (field)) {
+
+    const std::string_view literal = predicate.escaped;
+
+    switch (predicate.type) {
+
+      case PredicateType::kEquals:
+
+        matches = field == literal;
+        break;
+
+      case PredicateType::kPrefix:
+
+        matches = 0 == field.compare (0, literal.length (), literal);
+        break;
+
+      case PredicateType::kContains:
+
+        for (size_t found = FindSubstring (field, literal);
+             std::string_view::npos != found;
+             found = FindSubstring (field, literal, found + 1)) {
+
+          size_t backslashes = 0;
+          while (backslashes < found &&
+                 '\\' == field[found - backslashes - 1]) {
+
+            ++backslashes;
+
+          }
+
+          if (0 == backslashes % 2) {
+
+            matches = true;
+            break;
+
+          }
+
+        }
+        break;
+
+    }
+
+  } else {
+
+    // Rare: the field was not written by the serializer
+    std::string value;
+    this->_serializer.UnescapeField (field, value);
+
+    switch (predicate.type) {
+
+      case PredicateType::kEquals:
+
+        matches = value == predicate.value;
+        break;
+
+      case PredicateType::kPrefix:
+
+        matches = 0 == value.compare (0, predicate.value.length (),
+                                      predicate.value);
+        break;
+
+      case PredicateType::kContains:
+
+        matches = std::string::npos != value.find (predicate.value);
+        break;
+
+    }
+
+  }
+
+  return matches;
+
+}
+
+/**
+ * @brief Check whether a field only holds escapes the serializer writes
+ */
+bool RecordFilter::IsCanonical (std::string_view field) const {
+
+  const char delimiter = this->_serializer.Delimiter ()[0];
+  const char* data = field.data ();
+  const char* end = data + field.length ();
+
+  while (const char* backslash = static_cast<const char*> (
+           std::memchr (data, '\\', end - data))) {
+
+    if (backslash + 1 == end) { return false; }
+
+    const char next = backslash[1];
+
+    if ('\\' != next && 'n' != next && delimiter != next) { return false; }
+
+    data = backslash + 2;
+
+  }
+
+  return true;
+
+}
+
+} /* namespace WAZUH */
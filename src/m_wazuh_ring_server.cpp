@@ -0,0 +1,186 @@
+/*******************************************************************************
+ * @file m_wazuh_ring_server.cpp
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-11
+ * @version 1.0.0
+ * @changelog
+ * - v1.0.0: Initial implementation
+ * @brief Ring server implementation
+ *
+ * @details
+ * This file contains the implementation of the WAZUH::RingServer class.
+ * The consumer sleeps on the ring futex only when the ring is empty, so
+ * under load it never makes a system call besides the batch writes.
+ */
+
+
+/******************************************************************************
+ * Cpp Includes
+ */
+#include "m_wazuh_ring_server.h"
+
+#include <chrono>
+#include <string_view>
+#include <thread>
+
+
+/******************************************************************************
+ * C includes
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+ * Namespace declaration
+ */
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+
+// The stop flag is checked at least this often while the ring is idle
+constexpr std::chrono::milliseconds kRingPollInterval {100};
+
+// Time given to producers that reserved a slot before the ring was closed
+constexpr std::chrono::milliseconds kRingCloseGraceSlice {10};
+constexpr size_t kRingCloseGracePolls = 10;
+
+
+/******************************************************************************
+ * Implementation of public functions / methods
+ */
+
+/**
+ * @brief Constructor with serializer, ring and output
+ */
+RingServer::RingServer (const DelimitedSerializer& serializer, ShmRing& ring,
+                        int fd, size_t batch_records) :
+  _serializer {serializer},
+  _ring {ring},
+  _output {fd},
+  _batch_records {batch_records},
+  _buffer {},
+  _report {} {
+
+}
+
+/**
+ * @brief Serialize and write the records published so far
+ */
+size_t RingServer::DrainBatch (void) {
+
+  _buffer.clear ();
+
+  size_t drained = _ring.Drain (
+    [this] (std::string_view record) {
+
+      const size_t mark = _buffer.length ();
+
+      try {
+
+        _serializer.SerializeRecord (record, _buffer);
+        _buffer += '\n';
+
+      } catch (const serializer_error&) {
+
+        // A bad event must not stop the others
+        _buffer.resize (mark);
+        ++_report.rejected;
+
+      }
+
+    },
+    _batch_records);
+
+  if (!_buffer.empty ()) {
+
+    _output.Append (_buffer.data (), _buffer.length ());
+    _output.Flush ();
+
+    _report.output_bytes += _buffer.length ();
+
+  }
+
+  if (0 != drained) {
+
+    _report.records += drained;
+    ++_report.batches;
+
+  }
+
+  return drained;
+
+}
+
+/**
+ * @brief Drain the ring until asked to stop
+ */
+RingReport RingServer::Run (const std::atomic<bool>& stop) {
+
+  const auto start = std::chrono::steady_clock::now ();
+
+  while (!stop.load ()) {
+
+    if (0 == this->DrainBatch ()) {
+
+      _ring.WaitForRecords (kRingPollInterval);
+
+    }
+
+  }
+
+  _ring.Close ();
+
+  // Slots reserved before closing are published shortly after
+  for (size_t polls = 0; polls < kRingCloseGracePolls && 0 != _ring.Pending (); ) {
+
+    if (0 == this->DrainBatch ()) {
+
+      // A closed ring does not sleep on the futex
+      std::this_thread::sleep_for (kRingCloseGraceSlice);
+      ++polls;
+
+    }
+
+  }
+
+  const std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now () - start;
+
+  RingReport report = _report;
+  report.seconds = elapsed.count ();
+
+  return report;
+
+}
+
+/**
+ * @brief Get the figures accumulated so far
+ */
+const RingReport& RingServer::Report (void) const {
+
+  return _report;
+
+}
+
+
+/******************************************************************************
+ * Implementation of protected functions / methods
+ */
+
+
+/******************************************************************************
+ * Implementation of private functions / methods
+ */
+
+} /* namespace WAZUH */
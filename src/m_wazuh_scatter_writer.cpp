@@ -0,0 +1,179 @@
+/*******************************************************************************
+ * @file m_wazuh_scatter_writer.cpp
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-03
+ * @version 1.2.0
+ * @changelog
+ * - v1.0.0: Initial implementation
+ * - v1.1.0: Spans are only written on Flush
+ * - v1.2.0: Partial discard of the queued spans
+ * @brief Scatter Writer implementation
+ *
+ * @details
+ * This file contains the implementation of the WAZUH::ScatterWriter class.
+ * Spans are kept as iovec entries and written with writev, so the bytes go
+ * from the caller buffers to the kernel without intermediate copies. Nothing
+ * is written before Flush, which lets callers drop output they find invalid.
+ */
+
+
+/******************************************************************************
+ * Cpp Includes
+ */
+#include "m_wazuh_scatter_writer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+
+
+/******************************************************************************
+ * C includes
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <limits.h>
+#include <unistd.h>
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+ * Namespace declaration
+ */
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+#ifdef IOV_MAX
+constexpr size_t kMaxSpans = IOV_MAX;
+#else
+constexpr size_t kMaxSpans = 1024;
+#endif
+
+
+/******************************************************************************
+ * Implementation of public functions / methods
+ */
+
+/**
+ * @brief Constructor with output file descriptor
+ */
+ScatterWriter::ScatterWriter (int fd) : _fd {fd} {
+
+  this->_spans.reserve (kMaxSpans);
+
+}
+
+/**
+ * @brief Queue a span for output
+ */
+void ScatterWriter::Append (const char* data, size_t length) {
+
+  if (0 == length) { return; }
+
+  // Spans that continue the previous one are merged into a single entry
+  if (!this->_spans.empty ()) {
+
+    struct iovec& last = this->_spans.back ();
+
+    if (static_cast<const char*> (last.iov_base) + last.iov_len == data) {
+
+      last.iov_len += length;
+      return;
+
+    }
+
+  }
+
+  this->_spans.push_back ({const_cast<char*> (data), length});
+
+}
+
+/**
+ * @brief Write all queued spans and release them
+ */
+void ScatterWriter::Flush (void) {
+
+  struct iovec* spans = this->_spans.data ();
+  size_t count = this->_spans.size ();
+
+  while (count > 0) {
+
+    ssize_t written = ::writev (this->_fd, spans,
+                                static_cast<int> (std::min (count, kMaxSpans)));
+
+    if (written < 0) {
+
+      const int error = errno;
+
+      if (EINTR == error) { continue; }
+
+      this->_spans.clear ();
+      throw std::system_error (error, std::generic_category (), "writev");
+
+    }
+
+    // Skip the spans fully written and trim the partially written one
+    size_t remaining = static_cast<size_t> (written);
+
+    while (count > 0 && remaining >= spans->iov_len) {
+
+      remaining -= spans->iov_len;
+      ++spans;
+      --count;
+
+    }
+
+    if (count > 0) {
+
+      spans->iov_base = static_cast<char*> (spans->iov_base) + remaining;
+      spans->iov_len -= remaining;
+
+    }
+
+  }
+
+  this->_spans.clear ();
+
+}
+
+/**
+ * @brief Drop queued spans without writing them
+ */
+void ScatterWriter::Discard (size_t from) {
+
+  if (from < this->_spans.size ()) {
+
+    this->_spans.resize (from);
+
+  }
+
+}
+
+/**
+ * @brief Get the number of queued spans
+ */
+size_t ScatterWriter::Size (void) const {
+
+  return this->_spans.size ();
+
+}
+
+
+/******************************************************************************
+ * Implementation of protected functions / methods
+ */
+
+
+/******************************************************************************
+ * Implementation of private functions / methods
+ */
+
+} /* namespace WAZUH */
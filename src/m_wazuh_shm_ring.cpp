@@ -0,0 +1,588 @@
+/*******************************************************************************
+ * @file m_wazuh_shm_ring.cpp
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-11
+ * @version 1.0.0
+ * @changelog
+ * - v1.0.0: Initial implementation
+ * @brief Shared memory ring implementation
+ *
+ * @details
+ * This file contains the implementation of the WAZUH::ShmRing class. The
+ * slot protocol is the bounded queue of Dmitry Vyukov: a slot whose
+ * sequence equals a position is free for it, position + 1 means published,
+ * and the consumer frees it for the next lap with position + slot count.
+ */
+
+
+/******************************************************************************
+ * Cpp Includes
+ */
+#include "m_wazuh_shm_ring.h"
+
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <new>
+
+
+/******************************************************************************
+ * C includes
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+ * Namespace declaration
+ */
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+constexpr size_t kCacheLine = 64;
+constexpr uint64_t kRingMagic = 0x31474E495255585AULL;   // "ZXURING1"
+
+// Producers waiting for space recheck the ring this often
+constexpr std::chrono::milliseconds kSpaceWaitSlice {100};
+
+
+/******************************************************************************
+ * Class / Interfaces / Structs / Enums / Typedefs / Using declarations
+ */
+
+/**
+ * @brief Control block at the start of the shared memory
+ *
+ * Producer and consumer counters live on different cache lines. The magic
+ * is written last, so attaching producers never see a half built ring.
+ */
+struct alignas (kCacheLine) ShmRingHeader {
+  std::atomic<uint64_t> magic;
+  uint32_t slot_count;
+  uint32_t slot_size;
+  uint64_t slot_stride;
+  std::atomic<uint32_t> closed;
+  alignas (kCacheLine) std::atomic<uint64_t> head;           // Next position reserved
+  alignas (kCacheLine) std::atomic<uint64_t> tail;           // Next position drained
+  std::atomic<uint32_t> data_signal;                         // Futex the consumer sleeps on
+  std::atomic<uint32_t> consumer_waiting;
+  alignas (kCacheLine) std::atomic<uint32_t> space_signal;   // Futex full producers sleep on
+  std::atomic<uint32_t> producers_waiting;
+};
+
+/**
+ * @brief Slot header, followed by slot_size bytes of record
+ */
+struct ShmRingSlot {
+  std::atomic<uint64_t> sequence;
+  uint32_t length;
+};
+
+static_assert (std::atomic<uint32_t>::is_always_lock_free &&
+               std::atomic<uint64_t>::is_always_lock_free,
+               "Shared memory atomics must be lock free");
+static_assert (sizeof (std::atomic<uint32_t>) == sizeof (uint32_t),
+               "Futex words must be plain 32 bit integers");
+
+
+/******************************************************************************
+ * Local functions
+ */
+
+/**
+ * @brief Sleep while a futex word holds a value
+ * @param word Futex word, shared between processes
+ * @param expected Value observed before deciding to sleep
+ * @param timeout Maximum sleep
+ */
+static void FutexWait (std::atomic<uint32_t>& word, uint32_t expected,
+                       std::chrono::milliseconds timeout) {
+
+  struct timespec relative;
+  relative.tv_sec = timeout.count () / 1000;
+  relative.tv_nsec = (timeout.count () % 1000) * 1000000;
+
+  syscall (SYS_futex, reinterpret_cast<uint32_t*> (&word), FUTEX_WAIT,
+           expected, &relative, nullptr, 0);
+
+}
+
+/**
+ * @brief Wake every process sleeping on a futex word
+ * @param word Futex word, shared between processes
+ */
+static void FutexWake (std::atomic<uint32_t>& word) {
+
+  syscall (SYS_futex, reinterpret_cast<uint32_t*> (&word), FUTEX_WAKE,
+           INT_MAX, nullptr, nullptr, 0);
+
+}
+
+/**
+ * @brief Get the record bytes of a slot
+ */
+static char* SlotData (ShmRingSlot& slot) {
+
+  return reinterpret_cast<char*> (&slot) + sizeof (ShmRingSlot);
+
+}
+
+
+/******************************************************************************
+ * Implementation of public functions / methods
+ */
+
+/**
+ * @brief Constructor creating a ring, for the consumer
+ */
+ShmRing::ShmRing (std::string name, uint32_t slot_count, uint32_t slot_size) :
+  _name {std::move (name)},
+  _owner {true},
+  _memory {nullptr},
+  _length {0},
+  _header {nullptr},
+  _slots {nullptr} {
+
+  if (0 == slot_count || 0 != (slot_count & (slot_count - 1)) || 0 == slot_size) {
+
+    throw transport_error ("The slot count must be a power of two, and the slot size not zero.");
+
+  }
+
+  const uint64_t stride = (sizeof (ShmRingSlot) + slot_size + kCacheLine - 1) /
+                          kCacheLine * kCacheLine;
+
+  // A stale ring of a previous run would keep its old layout
+  shm_unlink (_name.c_str ());
+
+  int fd = shm_open (_name.c_str (), O_CREAT | O_EXCL | O_RDWR, 0600);
+
+  if (fd < 0) {
+
+    throw transport_error ("Cannot create ring '" + _name + "': " +
+                           std::strerror (errno));
+
+  }
+
+  const size_t length = sizeof (ShmRingHeader) + stride * slot_count;
+
+  if (0 != ftruncate (fd, static_cast<off_t> (length))) {
+
+    int error = errno;
+    close (fd);
+    shm_unlink (_name.c_str ());
+    throw transport_error ("Cannot size ring '" + _name + "': " +
+                           std::strerror (error));
+
+  }
+
+  try {
+
+    this->Map (fd, length);
+
+  } catch (const transport_error&) {
+
+    shm_unlink (_name.c_str ());
+    throw;
+
+  }
+
+  _header = new (_memory) ShmRingHeader ();
+  _header->slot_count = slot_count;
+  _header->slot_size = slot_size;
+  _header->slot_stride = stride;
+
+  for (uint64_t i = 0; i < slot_count; ++i) {
+
+    new (_slots + i * stride) ShmRingSlot {{i}, 0};
+
+  }
+
+  _header->magic.store (kRingMagic, std::memory_order_release);
+
+}
+
+/**
+ * @brief Constructor attaching to an existing ring, for producers
+ */
+ShmRing::ShmRing (std::string name) :
+  _name {std::move (name)},
+  _owner {false},
+  _memory {nullptr},
+  _length {0},
+  _header {nullptr},
+  _slots {nullptr} {
+
+  int fd = shm_open (_name.c_str (), O_RDWR, 0);
+
+  if (fd < 0) {
+
+    throw transport_error ("Cannot open ring '" + _name + "': " +
+                           std::strerror (errno));
+
+  }
+
+  struct stat status;
+
+  if (0 != fstat (fd, &status) ||
+      static_cast<size_t> (status.st_size) < sizeof (ShmRingHeader)) {
+
+    close (fd);
+    throw transport_error ("Ring '" + _name + "' is not initialized.");
+
+  }
+
+  this->Map (fd, static_cast<size_t> (status.st_size));
+
+  _header = static_cast<ShmRingHeader*> (_memory);
+
+  if (kRingMagic != _header->magic.load (std::memory_order_acquire)) {
+
+    munmap (_memory, _length);
+    throw transport_error ("Ring '" + _name + "' is not initialized.");
+
+  }
+
+  // Slot masks the position with slot_count - 1, any other layout would
+  // send records to the wrong slots or outside the mapping
+  const uint32_t slot_count = _header->slot_count;
+  const uint64_t stride = _header->slot_stride;
+
+  if (0 == slot_count || 0 != (slot_count & (slot_count - 1)) ||
+      0 == _header->slot_size ||
+      stride < sizeof (ShmRingSlot) + _header->slot_size ||
+      0 != stride % kCacheLine ||
+      (_length - sizeof (ShmRingHeader)) / stride < slot_count) {
+
+    munmap (_memory, _length);
+    throw transport_error ("Ring '" + _name + "' has an invalid layout.");
+
+  }
+
+}
+
+/**
+ * @brief Destructor, unmaps the ring and removes it if it was created
+ */
+ShmRing::~ShmRing () {
+
+  munmap (_memory, _length);
+
+  if (_owner) {
+
+    shm_unlink (_name.c_str ());
+
+  }
+
+}
+
+/**
+ * @brief Append a record, waiting while the ring is full
+ */
+void ShmRing::Push (std::string_view record) {
+
+  this->Publish (record, true);
+
+}
+
+/**
+ * @brief Append a record if there is a free slot
+ */
+bool ShmRing::TryPush (std::string_view record) {
+
+  return this->Publish (record, false);
+
+}
+
+/**
+ * @brief Consume the published records, consumer only
+ */
+size_t ShmRing::Drain (const std::function<void (std::string_view)>& consume,
+                       size_t max_records) {
+
+  const uint64_t start = _header->tail.load (std::memory_order_relaxed);
+  uint64_t position = start;
+
+  // Hand the slots up to 'end' back to the producers
+  auto release = [this, start] (uint64_t end) {
+
+    for (uint64_t i = start; i < end; ++i) {
+
+      this->Slot (i).sequence.store (i + _header->slot_count,
+                                     std::memory_order_release);
+
+    }
+
+    _header->tail.store (end, std::memory_order_release);
+
+    // Pairs with the fence of WaitForSpace
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+
+    if (end != start && 0 != _header->producers_waiting.load (std::memory_order_relaxed)) {
+
+      _header->space_signal.fetch_add (1);
+      FutexWake (_header->space_signal);
+
+    }
+
+  };
+
+  try {
+
+    while (position - start < max_records) {
+
+      ShmRingSlot& slot = this->Slot (position);
+
+      if (slot.sequence.load (std::memory_order_acquire) != position + 1) { break; }
+
+      ++position;
+      consume (std::string_view (SlotData (slot), slot.length));
+
+    }
+
+  } catch (...) {
+
+    release (position);
+    throw;
+
+  }
+
+  release (position);
+
+  return position - start;
+
+}
+
+/**
+ * @brief Wait until a record is published, consumer only
+ */
+bool ShmRing::WaitForRecords (std::chrono::milliseconds timeout) {
+
+  auto ready = [this] () {
+    const uint64_t tail = _header->tail.load (std::memory_order_relaxed);
+    return this->Slot (tail).sequence.load (std::memory_order_acquire) == tail + 1;
+  };
+
+  if (!ready ()) {
+
+    const uint32_t signal = _header->data_signal.load ();
+
+    _header->consumer_waiting.store (1);
+
+    // Pairs with the fence of Publish, one side always sees the other
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+
+    if (!ready () && !this->IsClosed ()) {
+
+      FutexWait (_header->data_signal, signal, timeout);
+
+    }
+
+    _header->consumer_waiting.store (0, std::memory_order_relaxed);
+
+  }
+
+  return ready ();
+
+}
+
+/**
+ * @brief Close the ring: pushes fail, waiting producers are woken
+ */
+void ShmRing::Close (void) {
+
+  _header->closed.store (1);
+
+  _header->space_signal.fetch_add (1);
+  FutexWake (_header->space_signal);
+
+  _header->data_signal.fetch_add (1);
+  FutexWake (_header->data_signal);
+
+}
+
+/**
+ * @brief Check whether the ring is closed
+ */
+bool ShmRing::IsClosed (void) const {
+
+  return 0 != _header->closed.load (std::memory_order_relaxed);
+
+}
+
+/**
+ * @brief Get the number of reserved records not drained yet
+ */
+size_t ShmRing::Pending (void) const {
+
+  return _header->head.load (std::memory_order_relaxed) -
+         _header->tail.load (std::memory_order_relaxed);
+
+}
+
+/**
+ * @brief Get the maximum record size
+ */
+size_t ShmRing::SlotSize (void) const {
+
+  return _header->slot_size;
+
+}
+
+
+/******************************************************************************
+ * Implementation of protected functions / methods
+ */
+
+
+/******************************************************************************
+ * Implementation of private functions / methods
+ */
+
+/**
+ * @brief Map the shared memory object
+ */
+void ShmRing::Map (int fd, size_t length) {
+
+  void* memory = mmap (nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  int error = errno;
+
+  // The mapping keeps the object alive, the descriptor is not needed
+  close (fd);
+
+  if (MAP_FAILED == memory) {
+
+    throw transport_error ("Cannot map ring '" + _name + "': " +
+                           std::strerror (error));
+
+  }
+
+  _memory = memory;
+  _length = length;
+  _slots = static_cast<char*> (memory) + sizeof (ShmRingHeader);
+
+}
+
+/**
+ * @brief Get the slot of a position
+ */
+ShmRingSlot& ShmRing::Slot (uint64_t position) const {
+
+  return *reinterpret_cast<ShmRingSlot*> (
+    _slots + (position & (_header->slot_count - 1)) * _header->slot_stride);
+
+}
+
+/**
+ * @brief Reserve, fill and publish a slot
+ */
+bool ShmRing::Publish (std::string_view record, bool wait) {
+
+  if (record.length () > _header->slot_size) {
+
+    throw transport_error ("Record of " + std::to_string (record.length ()) +
+                           " bytes exceeds the slot size.");
+
+  }
+
+  uint64_t position = _header->head.load (std::memory_order_relaxed);
+  ShmRingSlot* slot = nullptr;
+
+  for (;;) {
+
+    if (this->IsClosed ()) {
+
+      throw transport_error ("Ring '" + _name + "' is closed.");
+
+    }
+
+    slot = &this->Slot (position);
+
+    const int64_t difference = static_cast<int64_t> (
+      slot->sequence.load (std::memory_order_acquire) - position);
+
+    if (0 == difference) {
+
+      // Free slot, claim the position; on failure 'position' is reloaded
+      if (_header->head.compare_exchange_weak (position, position + 1,
+                                               std::memory_order_relaxed)) {
+        break;
+      }
+
+    } else if (difference < 0) {
+
+      // Still holds the record of the previous lap, the ring is full
+      if (!wait) { return false; }
+
+      this->WaitForSpace (position);
+      position = _header->head.load (std::memory_order_relaxed);
+
+    } else {
+
+      // Another producer took the position
+      position = _header->head.load (std::memory_order_relaxed);
+
+    }
+
+  }
+
+  std::memcpy (SlotData (*slot), record.data (), record.length ());
+  slot->length = static_cast<uint32_t> (record.length ());
+  slot->sequence.store (position + 1, std::memory_order_release);
+
+  // Pairs with the fence of WaitForRecords, one side always sees the other
+  std::atomic_thread_fence (std::memory_order_seq_cst);
+
+  if (0 != _header->consumer_waiting.load (std::memory_order_relaxed)) {
+
+    _header->data_signal.fetch_add (1);
+    FutexWake (_header->data_signal);
+
+  }
+
+  return true;
+
+}
+
+/**
+ * @brief Sleep until the consumer frees the slot of a position
+ */
+void ShmRing::WaitForSpace (uint64_t position) {
+
+  const uint32_t signal = _header->space_signal.load ();
+
+  _header->producers_waiting.fetch_add (1);
+
+  // Pairs with the fence of Drain, one side always sees the other
+  std::atomic_thread_fence (std::memory_order_seq_cst);
+
+  const int64_t difference = static_cast<int64_t> (
+    this->Slot (position).sequence.load (std::memory_order_acquire) - position);
+
+  if (difference < 0 && !this->IsClosed ()) {
+
+    FutexWait (_header->space_signal, signal, kSpaceWaitSlice);
+
+  }
+
+  _header->producers_waiting.fetch_sub (1);
+
+}
+
+} /* namespace WAZUH */
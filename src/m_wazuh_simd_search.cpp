@@ -0,0 +1,120 @@
+/*******************************************************************************
+ * @file m_wazuh_simd_search.cpp
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-08
+ * @version 1.0.0
+ * @changelog
+ * - v1.0.0: Initial implementation
+ * @brief SIMD substring search implementation
+ *
+ * @details
+ * This file contains the implementation of the first/last byte filter
+ * substring search. SSE2 is part of the x86-64 baseline, so no run time
+ * dispatch is needed; other targets use the standard library search.
+ */
+
+
+/******************************************************************************
+ * Cpp Includes
+ */
+#include "m_wazuh_simd_search.h"
+
+#include <cstring>
+
+
+/******************************************************************************
+ * C includes
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+ * Namespace declaration
+ */
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+#ifdef __SSE2__
+constexpr size_t kBlockSize = sizeof (__m128i);
+#endif
+
+
+/******************************************************************************
+ * Implementation of public functions / methods
+ */
+
+/**
+ * @brief Find the first occurrence of a needle in a haystack
+ */
+size_t FindSubstring (std::string_view haystack, std::string_view needle,
+                      size_t from) {
+
+  const size_t length = needle.length ();
+
+  if (from > haystack.length () || length > haystack.length () - from) {
+
+    return std::string_view::npos;
+
+  }
+
+  if (length <= 1) {
+
+    return haystack.find (needle, from);
+
+  }
+
+  size_t i = from;
+
+#ifdef __SSE2__
+  const char* data = haystack.data ();
+  const __m128i first = _mm_set1_epi8 (needle.front ());
+  const __m128i last = _mm_set1_epi8 (needle.back ());
+
+  for (; i + length - 1 + kBlockSize <= haystack.length (); i += kBlockSize) {
+
+    const __m128i block_first = _mm_loadu_si128 (
+      reinterpret_cast<const __m128i*> (data + i));
+    const __m128i block_last = _mm_loadu_si128 (
+      reinterpret_cast<const __m128i*> (data + i + length - 1));
+
+    // Bit n is set when position i + n starts and ends like the needle
+    unsigned mask = static_cast<unsigned> (_mm_movemask_epi8 (
+      _mm_and_si128 (_mm_cmpeq_epi8 (first, block_first),
+                     _mm_cmpeq_epi8 (last, block_last))));
+
+    while (0 != mask) {
+
+      const size_t candidate = i + __builtin_ctz (mask);
+
+      if (0 == std::memcmp (data + candidate + 1, needle.data () + 1,
+                            length - 2)) {
+
+        return candidate;
+
+      }
+
+      mask &= mask - 1;
+
+    }
+
+  }
+#endif
+
+  return haystack.find (needle, i);
+
+}
+
+} /* namespace WAZUH */
@@ -0,0 +1,297 @@
+/*******************************************************************************
+ * @file m_wazuh_thread_pool.cpp
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-04
+ * @version 1.0.0
+ * @changelog
+ * - v1.0.0: Initial implementation
+ * @brief Work stealing thread pool implementation
+ *
+ * @details
+ * This file contains the implementation of the WAZUH::WorkStealingPool class.
+ * Tasks are taken and stolen under the lock of the queue holding them only.
+ * Atomic counters of queued and pending tasks tell the workers when to
+ * sleep, and the shared mutex is only taken to sleep and to wake a sleeper.
+ */
+
+
+/******************************************************************************
+ * Cpp Includes
+ */
+#include "m_wazuh_thread_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+
+/******************************************************************************
+ * C includes
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  // C headers here
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+ * Namespace declaration
+ */
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+
+// Pool and queue of the worker running on the current thread, if any
+static thread_local const WorkStealingPool* tls_pool = nullptr;
+static thread_local size_t tls_queue_index = 0;
+
+
+/******************************************************************************
+ * Implementation of public functions / methods
+ */
+
+/**
+ * @brief Constructor with the number of workers
+ */
+WorkStealingPool::WorkStealingPool (size_t thread_count) :
+  _queued {0},
+  _pending {0},
+  _next_queue {0},
+  _sleepers {0},
+  _stopping {false} {
+
+  thread_count = std::max<size_t> (thread_count, 1);
+
+  for (size_t i = 0; i < thread_count; ++i) {
+
+    this->_queues.push_back (std::make_unique<WorkerQueue> ());
+
+  }
+
+  for (size_t i = 0; i < thread_count; ++i) {
+
+    this->_workers.emplace_back (&WorkStealingPool::WorkerLoop, this, i);
+
+  }
+
+}
+
+/**
+ * @brief Destructor. Waits for the workers to finish their queues
+ */
+WorkStealingPool::~WorkStealingPool () {
+
+  {
+    std::lock_guard<std::mutex> lock (this->_state_mutex);
+    this->_stopping = true;
+  }
+
+  this->_work_available.notify_all ();
+
+  for (auto& worker : this->_workers) {
+
+    worker.join ();
+
+  }
+
+}
+
+/**
+ * @brief Queue a task for execution
+ */
+void WorkStealingPool::Submit (Task task) {
+
+  size_t index = 0;
+
+  this->_pending.fetch_add (1);
+
+  // Workers keep their own tasks, other threads spread them round robin
+  if (this == tls_pool) {
+
+    index = tls_queue_index;
+
+  } else {
+
+    index = this->_next_queue.fetch_add (1) % this->_queues.size ();
+
+  }
+
+  {
+    std::lock_guard<std::mutex> lock (this->_queues[index]->mutex);
+    this->_queues[index]->tasks.push_back (std::move (task));
+  }
+
+  // The task is only announced once it can be taken from its queue. A worker
+  // going to sleep counts itself before checking _queued, so either it sees
+  // the task or this sees the sleeper
+  this->_queued.fetch_add (1);
+
+  if (0 != this->_sleepers.load ()) {
+
+    std::lock_guard<std::mutex> lock (this->_state_mutex);
+    this->_work_available.notify_one ();
+
+  }
+
+}
+
+/**
+ * @brief Block until every submitted task has finished
+ */
+void WorkStealingPool::Wait (void) {
+
+  std::unique_lock<std::mutex> lock (this->_state_mutex);
+
+  this->_all_done.wait (lock, [this] { return 0 == this->_pending.load (); });
+
+  if (this->_first_error) {
+
+    std::exception_ptr error = std::move (this->_first_error);
+    this->_first_error = nullptr;
+    std::rethrow_exception (error);
+
+  }
+
+}
+
+/**
+ * @brief Get the number of worker threads
+ */
+size_t WorkStealingPool::Size (void) const {
+
+  return this->_workers.size ();
+
+}
+
+
+/******************************************************************************
+ * Implementation of protected functions / methods
+ */
+
+
+/******************************************************************************
+ * Implementation of private functions / methods
+ */
+
+/**
+ * @brief Worker thread main loop
+ */
+void WorkStealingPool::WorkerLoop (size_t index) {
+
+  tls_pool = this;
+  tls_queue_index = index;
+
+  for (;;) {
+
+    Task task;
+
+    if (this->TakeTask (index, task)) {
+
+      this->_queued.fetch_sub (1);
+      this->RunTask (task);
+      continue;
+
+    }
+
+    std::unique_lock<std::mutex> lock (this->_state_mutex);
+
+    this->_sleepers.fetch_add (1);
+    this->_work_available.wait (lock, [this] {
+      return this->_stopping || 0 != this->_queued.load ();
+    });
+    this->_sleepers.fetch_sub (1);
+
+    // Queues are drained before the workers are allowed to stop
+    if (this->_stopping && 0 == this->_queued.load ()) { break; }
+
+  }
+
+  tls_pool = nullptr;
+
+}
+
+/**
+ * @brief Take a task from the own queue or steal one from another
+ */
+bool WorkStealingPool::TakeTask (size_t index, Task& task) {
+
+  bool taken = false;
+
+  {
+    WorkerQueue& own = *this->_queues[index];
+    std::lock_guard<std::mutex> lock (own.mutex);
+
+    if (!own.tasks.empty ()) {
+
+      task = std::move (own.tasks.back ());
+      own.tasks.pop_back ();
+      taken = true;
+
+    }
+  }
+
+  for (size_t i = 1; !taken && i < this->_queues.size (); ++i) {
+
+    WorkerQueue& victim = *this->_queues[(index + i) % this->_queues.size ()];
+    std::lock_guard<std::mutex> lock (victim.mutex);
+
+    if (!victim.tasks.empty ()) {
+
+      task = std::move (victim.tasks.front ());
+      victim.tasks.pop_front ();
+      taken = true;
+
+    }
+
+  }
+
+  return taken;
+
+}
+
+/**
+ * @brief Run a task and account for its completion
+ */
+void WorkStealingPool::RunTask (Task& task) {
+
+  std::exception_ptr error;
+
+  try {
+
+    task ();
+
+  } catch (...) {
+
+    error = std::current_exception ();
+
+  }
+
+  // Release whatever the task captured before reporting it as done
+  task = nullptr;
+
+  if (error) {
+
+    std::lock_guard<std::mutex> lock (this->_state_mutex);
+
+    if (!this->_first_error) { this->_first_error = error; }
+
+  }
+
+  // Notified under the lock, so Wait cannot miss it between check and sleep
+  if (1 == this->_pending.fetch_sub (1)) {
+
+    std::lock_guard<std::mutex> lock (this->_state_mutex);
+    this->_all_done.notify_all ();
+
+  }
+
+}
+
+} /* namespace WAZUH */
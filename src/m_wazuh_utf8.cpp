@@ -0,0 +1,341 @@
+/*******************************************************************************
+ * @file m_wazuh_utf8.cpp
+ * @author Roberto Enrique Castro Beltran
+ * @date 2025-11-10
+ * @version 1.0.0
+ * @changelog
+ * - v1.0.0: Initial implementation
+ * @brief UTF-8 validation implementation
+ *
+ * @details
+ * This file contains the UTF-8 validation. The SSSE3 version is the lookup
+ * table algorithm of Keiser and Lemire, as used by simdjson and simdutf: the
+ * high and low nibbles of every byte and the high nibble of the next one
+ * index three tables whose AND flags every malformed pair, and 3 and 4 byte
+ * sequences are checked by comparing the continuation bytes they require
+ * with the ones found. It is compiled for that target only and selected at
+ * run time.
+ */
+
+
+/******************************************************************************
+ * Cpp Includes
+ */
+#include "m_wazuh_utf8.h"
+
+#include <cstdint>
+#include <cstring>
+
+
+/******************************************************************************
+ * C includes
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <tmmintrin.h>
+#define WAZUH_UTF8_HAS_SSSE3 1
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+
+/******************************************************************************
+ * Namespace declaration
+ */
+namespace WAZUH {
+
+
+/******************************************************************************
+* Constants and macros definitions
+*/
+#ifdef WAZUH_UTF8_HAS_SSSE3
+
+constexpr size_t kBlockSize = sizeof (__m128i);
+
+// Error classes of a pair of bytes, see the tables below
+constexpr uint8_t kTooShort     = 1 << 0;   // 11______ 0_______, 11______ 11______
+constexpr uint8_t kTooLong      = 1 << 1;   // 0_______ 10______
+constexpr uint8_t kOverlong3    = 1 << 2;   // 11100000 100_____
+constexpr uint8_t kTooLarge     = 1 << 3;   // 11110100 1001____ and above
+constexpr uint8_t kSurrogate    = 1 << 4;   // 11101101 101_____
+constexpr uint8_t kOverlong2    = 1 << 5;   // 1100000_ 10______
+constexpr uint8_t kTooLarge1000 = 1 << 6;   // 11110101 1000____ and above
+constexpr uint8_t kOverlong4    = 1 << 6;   // 11110000 1000____
+constexpr uint8_t kTwoConts     = 1 << 7;   // 10______ 10______
+constexpr uint8_t kCarry        = kTooShort | kTooLong | kTwoConts;
+
+// Indexed by the high nibble of the first byte of the pair
+alignas (16) constexpr uint8_t kByte1High[16] = {
+  kTooLong, kTooLong, kTooLong, kTooLong,
+  kTooLong, kTooLong, kTooLong, kTooLong,
+  kTwoConts, kTwoConts, kTwoConts, kTwoConts,
+  kTooShort | kOverlong2,
+  kTooShort,
+  kTooShort | kOverlong3 | kSurrogate,
+  kTooShort | kTooLarge | kTooLarge1000 | kOverlong4
+};
+
+// Indexed by the low nibble of the first byte of the pair
+alignas (16) constexpr uint8_t kByte1Low[16] = {
+  kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+  kCarry | kOverlong2,
+  kCarry,
+  kCarry,
+  kCarry | kTooLarge,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000
+};
+
+// Indexed by the high nibble of the second byte of the pair
+alignas (16) constexpr uint8_t kByte2High[16] = {
+  kTooShort, kTooShort, kTooShort, kTooShort,
+  kTooShort, kTooShort, kTooShort, kTooShort,
+  kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 | kOverlong4,
+  kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,
+  kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+  kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+  kTooShort, kTooShort, kTooShort, kTooShort
+};
+
+// A block ending above these bytes ends inside a multi byte sequence
+alignas (16) constexpr uint8_t kIncompleteMax[16] = {
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF
+};
+
+#endif
+
+
+/******************************************************************************
+ * Local functions
+ */
+
+/**
+ * @brief Decode the sequence starting at a byte
+ * @param data Bytes from the start of the sequence
+ * @param length Number of bytes available
+ * @param valid Output, true if the sequence is well formed
+ * @return Bytes in the sequence, or in its maximal invalid subpart
+ */
+static size_t DecodeSequence (const unsigned char* data, size_t length,
+                              bool& valid) {
+
+  const unsigned char lead = data[0];
+  size_t continuations = 0;
+  unsigned char low = 0x80;     // Range of the first continuation byte
+  unsigned char high = 0xBF;
+
+  valid = false;
+
+  if (lead < 0x80) { valid = true; return 1; }
+  else if (lead >= 0xC2 && lead <= 0xDF) { continuations = 1; }
+  else if (0xE0 == lead) { continuations = 2; low = 0xA0; }
+  else if (0xED == lead) { continuations = 2; high = 0x9F; }
+  else if (lead >= 0xE1 && lead <= 0xEF) { continuations = 2; }
+  else if (0xF0 == lead) { continuations = 3; low = 0x90; }
+  else if (0xF4 == lead) { continuations = 3; high = 0x8F; }
+  else if (lead >= 0xF1 && lead <= 0xF3) { continuations = 3; }
+  else { return 1; }
+
+  size_t i = 1;
+
+  for (; i <= continuations && i < length; ++i) {
+
+    if (data[i] < low || data[i] > high) { return i; }
+
+    low = 0x80;
+    high = 0xBF;
+
+  }
+
+  valid = i > continuations;
+
+  return i;
+
+}
+
+/**
+ * @brief Scalar validation, used when SSSE3 is not available
+ */
+static bool IsValidUtf8Scalar (std::string_view text) {
+
+  return std::string_view::npos == FindInvalidUtf8 (text).position;
+
+}
+
+#ifdef WAZUH_UTF8_HAS_SSSE3
+
+/**
+ * @brief Shift every byte of a vector right by 4 bits
+ */
+__attribute__ ((target ("ssse3")))
+static inline __m128i HighNibbles (__m128i input) {
+
+  return _mm_and_si128 (_mm_srli_epi16 (input, 4), _mm_set1_epi8 (0x0F));
+
+}
+
+/**
+ * @brief Check a block of 16 bytes against the previous one
+ * @param input The block
+ * @param previous Previous block, zero at the start
+ * @param incomplete Previous block ends inside a sequence. Updated
+ * @param error Accumulated error bits. Updated
+ */
+__attribute__ ((target ("ssse3")))
+static inline void CheckBlock (__m128i input, __m128i& previous,
+                               __m128i& incomplete, __m128i& error) {
+
+  if (0 == _mm_movemask_epi8 (input)) {
+
+    // ASCII, only a sequence left open by the previous block is an error
+    error = _mm_or_si128 (error, incomplete);
+    incomplete = _mm_setzero_si128 ();
+    previous = input;
+    return;
+
+  }
+
+  const __m128i prev1 = _mm_alignr_epi8 (input, previous, 15);
+  const __m128i prev2 = _mm_alignr_epi8 (input, previous, 14);
+  const __m128i prev3 = _mm_alignr_epi8 (input, previous, 13);
+
+  const __m128i byte_1_high = _mm_shuffle_epi8 (
+    _mm_load_si128 (reinterpret_cast<const __m128i*> (kByte1High)),
+    HighNibbles (prev1));
+  const __m128i byte_1_low = _mm_shuffle_epi8 (
+    _mm_load_si128 (reinterpret_cast<const __m128i*> (kByte1Low)),
+    _mm_and_si128 (prev1, _mm_set1_epi8 (0x0F)));
+  const __m128i byte_2_high = _mm_shuffle_epi8 (
+    _mm_load_si128 (reinterpret_cast<const __m128i*> (kByte2High)),
+    HighNibbles (input));
+
+  const __m128i special = _mm_and_si128 (_mm_and_si128 (byte_1_high, byte_1_low),
+                                         byte_2_high);
+
+  // High bit set where the byte must be the 2nd or 3rd continuation
+  const __m128i third = _mm_subs_epu8 (prev2, _mm_set1_epi8 (0xE0 - 0x80));
+  const __m128i fourth = _mm_subs_epu8 (prev3, _mm_set1_epi8 (0xF0 - 0x80));
+  const __m128i must_continue = _mm_and_si128 (_mm_or_si128 (third, fourth),
+                                               _mm_set1_epi8 (static_cast<char> (0x80)));
+
+  // A required continuation shows up as kTwoConts in the special cases
+  error = _mm_or_si128 (error, _mm_xor_si128 (must_continue, special));
+
+  incomplete = _mm_subs_epu8 (input,
+    _mm_load_si128 (reinterpret_cast<const __m128i*> (kIncompleteMax)));
+  previous = input;
+
+}
+
+/**
+ * @brief SSSE3 validation, 16 bytes per step
+ */
+__attribute__ ((target ("ssse3")))
+static bool IsValidUtf8Ssse3 (std::string_view text) {
+
+  const char* data = text.data ();
+  const size_t length = text.length ();
+
+  __m128i previous = _mm_setzero_si128 ();
+  __m128i incomplete = _mm_setzero_si128 ();
+  __m128i error = _mm_setzero_si128 ();
+
+  size_t i = 0;
+
+  for (; i + kBlockSize <= length; i += kBlockSize) {
+
+    CheckBlock (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (data + i)),
+                previous, incomplete, error);
+
+  }
+
+  if (i < length) {
+
+    // Padding with ASCII zeros closes no sequence and opens none
+    alignas (16) char tail[kBlockSize] = {};
+    std::memcpy (tail, data + i, length - i);
+
+    CheckBlock (_mm_load_si128 (reinterpret_cast<const __m128i*> (tail)),
+                previous, incomplete, error);
+
+  }
+
+  error = _mm_or_si128 (error, incomplete);
+
+  return 0xFFFF == _mm_movemask_epi8 (_mm_cmpeq_epi8 (error, _mm_setzero_si128 ()));
+
+}
+
+#endif
+
+
+/******************************************************************************
+ * Implementation of public functions / methods
+ */
+
+/**
+ * @brief Check whether a buffer is valid UTF-8
+ */
+bool IsValidUtf8 (std::string_view text) {
+
+#ifdef WAZUH_UTF8_HAS_SSSE3
+  static const bool has_ssse3 = __builtin_cpu_supports ("ssse3");
+
+  if (has_ssse3) {
+
+    return IsValidUtf8Ssse3 (text);
+
+  }
+#endif
+
+  return IsValidUtf8Scalar (text);
+
+}
+
+/**
+ * @brief Find the first malformed sequence of a buffer
+ */
+Utf8Error FindInvalidUtf8 (std::string_view text, size_t from) {
+
+  const unsigned char* data = reinterpret_cast<const unsigned char*> (text.data ());
+  const size_t length = text.length ();
+
+  size_t i = from;
+
+  while (i < length) {
+
+    if (data[i] < 0x80) { ++i; continue; }
+
+    bool valid = false;
+    const size_t sequence = DecodeSequence (data + i, length - i, valid);
+
+    if (!valid) {
+
+      return Utf8Error {i, sequence};
+
+    }
+
+    i += sequence;
+
+  }
+
+  return Utf8Error {std::string_view::npos, 0};
+
+}
+
+} /* namespace WAZUH */
@@ -2,13 +2,27 @@
  * @file main.cpp
  * @author Roberto Enrique Castro Beltran
  * @date 2025-11-02
- * @version 1.0.0
+ * @version 2.2.0
  * @changelog
  * - v1.0.0: Initial implementation
- * @brief ...
+ * - v1.1.0: Scatter-gather deserialize output
+ * - v1.2.0: Multi-file batch mode
+ * - v1.3.0: Dictionary format
+ * - v1.4.0: Columnar format and single column output
+ * - v1.5.0: CRC32C record checksum option
+ * - v1.6.0: Filtered deserialization
+ * - v1.7.0: Multi character delimiters
+ * - v1.8.0: transcode-json mode
+ * - v1.9.0: bench mode
+ * - v2.0.0: Compile time option schema, unknown and repeated options rejected
+ * - v2.1.0: UTF-8 policy option
+ * - v2.2.0: Shared memory ring modes
+ * @brief Serializer command line entry point
  *
  * @details
- * ...
+ * Parses the command line, checks that the options fit together and runs
+ * the selected mode. Every mode has its own Run function, main only builds
+ * the serializers they share and reports the errors.
  *
  */
 
@@ -16,12 +30,31 @@
 /******************************************************************************
  * Cpp Includes
  */
+#include <cctype>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <atomic>
 #include <iostream>
+#include <iterator>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
 #include <vector>
 
+#include "m_wazuh_alloc_tracker.h"
 #include "m_wazuh_arg_parser.h"
+#include "m_wazuh_batch_runner.h"
+#include "m_wazuh_benchmark.h"
+#include "m_wazuh_columnar_serializer.h"
 #include "m_wazuh_delimited_serializer.h"
+#include "m_wazuh_dictionary_serializer.h"
+#include "m_wazuh_json_transcoder.h"
+#include "m_wazuh_record_filter.h"
+#include "m_wazuh_ring_server.h"
+#include "m_wazuh_scatter_writer.h"
 
 /******************************************************************************
  * C includes
@@ -30,7 +63,8 @@
 extern "C" {
 #endif
 
-  // C headers here
+#include <signal.h>
+#include <unistd.h>
 
 #ifdef __cplusplus
 }
@@ -47,61 +81,603 @@ constexpr char kHelpOption[]    = "help";
 constexpr char kHelpDescription[] = "Show help information";
 
 constexpr char kModeOption[]    = "mode";
-constexpr char kModeDescription[] = "Mode: serialize or deserialize";
+constexpr char kModeDescription[] = "Mode: serialize, deserialize, transcode-json, bench, ring-serve or ring-push";
 
 constexpr char kDelimiterOption[]    = "delimiter";
-constexpr char kDelimiterDescription[] = "Delimiter character";
+constexpr char kDelimiterDescription[] = "Delimiter, one or more characters. '\\xHH' gives a byte in hex";
+
+constexpr char kFormatOption[]    = "format";
+constexpr char kFormatDescription[] = "Format: delimited, dictionary or columnar. Defaults to delimited";
+
+constexpr char kColumnOption[]    = "column";
+constexpr char kColumnDescription[] = "Columnar deserialize: only output this column, starting at 0";
+
+constexpr char kChecksumOption[]    = "checksum";
+constexpr char kChecksumDescription[] = "Record checksum: none or crc32c. Defaults to none";
+
+constexpr char kUtf8Option[]    = "utf8";
+constexpr char kUtf8Description[] = "Malformed UTF-8: accept, reject, replace or escape. Defaults to accept";
+
+constexpr char kColumnsOption[]    = "columns";
+constexpr char kColumnsDescription[] = "JSON transcoding: comma separated column names, to write objects instead of arrays";
+
+constexpr char kFilterOption[]    = "filter";
+constexpr char kFilterDescription[] = "Deserialize only the records matching 'N=value', 'N^prefix' or 'N~text', joined by '&&'";
+
+constexpr char kBatchOption[]    = "batch";
+constexpr char kBatchDescription[] = "Batch input: a directory or a comma separated list of files";
+
+constexpr char kOutputDirOption[]    = "output-dir";
+constexpr char kOutputDirDescription[] = "Batch output directory";
+
+constexpr char kThreadsOption[]    = "threads";
+constexpr char kThreadsDescription[] = "Batch worker threads, defaults to the number of cores. ring-push: producer threads, defaults to 1";
+
+constexpr char kRingOption[]    = "ring";
+constexpr char kRingDescription[] = "Shared memory ring name, e.g. /wazuh-ring. Used by ring-serve and ring-push";
+
+constexpr char kIterationsOption[]    = "iterations";
+constexpr char kIterationsDescription[] = "Bench: measured passes over the corpus, defaults to 10. ring-push: pushes per thread, defaults to 1";
+
+constexpr WAZUH::ArgOption kOptions[] = {
+  {kHelpOption,       'h', WAZUH::ArgRequirement::kOptional,  kHelpDescription},
+  {kModeOption,       'm', WAZUH::ArgRequirement::kMandatory, kModeDescription},
+  {kDelimiterOption,  'd', WAZUH::ArgRequirement::kOptional,  kDelimiterDescription, ","},
+  {kFormatOption,     'f', WAZUH::ArgRequirement::kOptional,  kFormatDescription, "delimited"},
+  {kColumnOption,     'c', WAZUH::ArgRequirement::kOptional,  kColumnDescription},
+  {kChecksumOption,   'k', WAZUH::ArgRequirement::kOptional,  kChecksumDescription, "none"},
+  {kUtf8Option,       'u', WAZUH::ArgRequirement::kOptional,  kUtf8Description, "accept"},
+  {kColumnsOption,    'n', WAZUH::ArgRequirement::kOptional,  kColumnsDescription},
+  {kFilterOption,     'F', WAZUH::ArgRequirement::kOptional,  kFilterDescription},
+  {kBatchOption,      'b', WAZUH::ArgRequirement::kOptional,  kBatchDescription},
+  {kOutputDirOption,  'o', WAZUH::ArgRequirement::kOptional,  kOutputDirDescription},
+  {kThreadsOption,    'j', WAZUH::ArgRequirement::kOptional,  kThreadsDescription},
+  {kRingOption,       'r', WAZUH::ArgRequirement::kOptional,  kRingDescription},
+  {kIterationsOption, 'i', WAZUH::ArgRequirement::kOptional,  kIterationsDescription},
+};
+
+// Built at compile time, a bad table or an unknown key fails the build
+constexpr WAZUH::ArgSchema kSchema (kAppName, kAppDescription, kOptions);
+
+constexpr WAZUH::ArgKey kModeKey       = kSchema.Key (kModeOption);
+constexpr WAZUH::ArgKey kDelimiterKey  = kSchema.Key (kDelimiterOption);
+constexpr WAZUH::ArgKey kFormatKey     = kSchema.Key (kFormatOption);
+constexpr WAZUH::ArgKey kColumnKey     = kSchema.Key (kColumnOption);
+constexpr WAZUH::ArgKey kChecksumKey   = kSchema.Key (kChecksumOption);
+constexpr WAZUH::ArgKey kUtf8Key       = kSchema.Key (kUtf8Option);
+constexpr WAZUH::ArgKey kColumnsKey    = kSchema.Key (kColumnsOption);
+constexpr WAZUH::ArgKey kFilterKey     = kSchema.Key (kFilterOption);
+constexpr WAZUH::ArgKey kBatchKey      = kSchema.Key (kBatchOption);
+constexpr WAZUH::ArgKey kOutputDirKey  = kSchema.Key (kOutputDirOption);
+constexpr WAZUH::ArgKey kThreadsKey    = kSchema.Key (kThreadsOption);
+constexpr WAZUH::ArgKey kIterationsKey = kSchema.Key (kIterationsOption);
+constexpr WAZUH::ArgKey kRingKey       = kSchema.Key (kRingOption);
+
+/**
+ * @brief Operating modes
+ */
+enum class Mode { kSerialize, kDeserialize, kTranscodeJson, kBench, kRingServe, kRingPush };
+
+/**
+ * @brief Serialized formats
+ */
+enum class Format { kDelimited, kDictionary, kColumnar };
+
+constexpr WAZUH::ArgChoice<Mode> kModes[] = {
+  {"serialize", Mode::kSerialize},
+  {"deserialize", Mode::kDeserialize},
+  {"transcode-json", Mode::kTranscodeJson},
+  {"bench", Mode::kBench},
+  {"ring-serve", Mode::kRingServe},
+  {"ring-push", Mode::kRingPush},
+};
+
+constexpr WAZUH::ArgChoice<Format> kFormats[] = {
+  {"delimited", Format::kDelimited},
+  {"dictionary", Format::kDictionary},
+  {"columnar", Format::kColumnar},
+};
+
+constexpr WAZUH::ArgChoice<bool> kChecksums[] = {
+  {"none", false},
+  {"crc32c", true},
+};
+
+constexpr WAZUH::ArgChoice<WAZUH::Utf8Policy> kUtf8Policies[] = {
+  {"accept", WAZUH::Utf8Policy::kAccept},
+  {"reject", WAZUH::Utf8Policy::kReject},
+  {"replace", WAZUH::Utf8Policy::kReplace},
+  {"escape", WAZUH::Utf8Policy::kEscape},
+};
+
+constexpr double kMegabyte = 1024.0 * 1024.0;
+
+constexpr char kHexEscape[] = "\\x";
+constexpr size_t kHexEscapeLength = sizeof (kHexEscape) - 1 + 2;
 
 
 /******************************************************************************
- * Implementation of public functions / methods
+ * Local functions
  */
 
+// Set by SIGINT and SIGTERM, ends the ring-serve mode
+static std::atomic<bool> g_stop_requested {false};
+
 /**
- * @brief Main entry point of the application
+ * @brief Signal handler requesting a clean stop
+ * @param signal_number Received signal, unused
  */
-int main (int argc, char* argv[]) {
+static void RequestStop (int signal_number) {
+
+  (void) signal_number;
+  g_stop_requested.store (true);
+
+}
+
+/**
+ * @brief Decode the '\xHH' escapes of a delimiter given in the command line
+ * @param value Option value
+ * @return Delimiter bytes. Other characters are kept as they are
+ */
+static std::string DecodeDelimiter (std::string_view value) {
+
+  std::string delimiter;
+
+  for (size_t i = 0; i < value.length (); ++i) {
+
+    if (0 == value.compare (i, sizeof (kHexEscape) - 1, kHexEscape) &&
+        i + kHexEscapeLength <= value.length () &&
+        std::isxdigit (static_cast<unsigned char> (value[i + 2])) &&
+        std::isxdigit (static_cast<unsigned char> (value[i + 3]))) {
+
+      delimiter += static_cast<char> (
+        std::stoi (std::string (value.substr (i + 2, 2)), nullptr, 16));
+      i += kHexEscapeLength - 1;
+
+    } else {
+
+      delimiter += value[i];
+
+    }
+
+  }
+
+  return delimiter;
+
+}
+
+/**
+ * @brief Reject the options that do not apply to the selected mode and format
+ * @param arg_parser Parsed command line
+ * @param mode Selected mode
+ * @param format Selected format
+ * @param delimited_serializer Delimited serializer with the checksum and UTF-8 policy set
+ */
+static void CheckOptions (const WAZUH::ArgParser& arg_parser, Mode mode, Format format,
+                          const WAZUH::DelimitedSerializer& delimited_serializer) {
+
+  const bool delimited = Format::kDelimited == format;
+  const bool batch = !arg_parser[kBatchKey].empty ();
+
+  if (!delimited && delimited_serializer.HasChecksum ()) {
+
+    throw WAZUH::arg_parser_error ("Option '--checksum' requires the delimited format.");
+
+  }
+
+  if (!delimited &&
+      WAZUH::Utf8Policy::kAccept != delimited_serializer.GetUtf8Policy ()) {
+
+    throw WAZUH::arg_parser_error ("Option '--utf8' requires the delimited format.");
+
+  }
+
+  if (!arg_parser[kFilterKey].empty () &&
+      (!delimited || Mode::kDeserialize != mode || batch)) {
+
+    throw WAZUH::arg_parser_error ("Option '--filter' requires delimited deserialization on stdin.");
+
+  }
+
+  if (!arg_parser[kColumnsKey].empty () && Mode::kTranscodeJson != mode) {
+
+    throw WAZUH::arg_parser_error ("Option '--columns' requires mode 'transcode-json'.");
+
+  }
+
+  if (Mode::kTranscodeJson == mode && (!delimited || batch)) {
+
+    throw WAZUH::arg_parser_error ("Mode 'transcode-json' only supports the delimited format on stdin.");
+
+  }
+
+  if (Mode::kBench == mode && (!delimited || batch)) {
+
+    throw WAZUH::arg_parser_error ("Mode 'bench' only supports the delimited format on stdin.");
+
+  }
+
+  if ((Mode::kRingServe == mode || Mode::kRingPush == mode) &&
+      (arg_parser[kRingKey].empty () || !delimited || batch)) {
+
+    throw WAZUH::arg_parser_error ("Ring modes require '--ring' and the delimited format, without '--batch'.");
+
+  }
+
+  if (!arg_parser[kColumnKey].empty () &&
+      (Format::kColumnar != format || Mode::kDeserialize != mode || batch)) {
+
+    throw WAZUH::arg_parser_error ("Option '--column' requires columnar deserialization on stdin.");
+
+  }
+
+  if (batch && !delimited) {
+
+    throw WAZUH::arg_parser_error ("Batch mode only supports the delimited format.");
+
+  }
+
+}
+
+/**
+ * @brief Serialize or deserialize every file of '--batch' into '--output-dir'
+ * @param arg_parser Parsed command line
+ * @param mode kSerialize or kDeserialize
+ * @param delimited_serializer Serializer shared by the workers
+ * @return Exit code
+ */
+static int RunBatch (const WAZUH::ArgParser& arg_parser, Mode mode,
+                     const WAZUH::DelimitedSerializer& delimited_serializer) {
+
+  std::filesystem::path output_dir = arg_parser.GetPath (kOutputDirKey);
+  size_t threads = arg_parser.GetInteger (kThreadsKey,
+                                          std::thread::hardware_concurrency (),
+                                          1);
+
+  if (output_dir.empty ()) {
+
+    throw WAZUH::arg_parser_error ("Batch mode requires an output directory.");
+
+  }
+
+  WAZUH::BatchRunner runner (delimited_serializer, threads);
+  WAZUH::BatchReport report =
+    runner.Run (Mode::kSerialize == mode ? WAZUH::BatchMode::kSerialize
+                                         : WAZUH::BatchMode::kDeserialize,
+                WAZUH::BatchRunner::ListInputs (std::string (arg_parser[kBatchKey])),
+                output_dir.string ());
+
+  double megabytes = static_cast<double> (report.input_bytes) / kMegabyte;
+
+  std::cerr << "Batch: " << report.files << " files, "
+            << report.chunks << " chunks, "
+            << report.input_bytes << " bytes in, "
+            << report.output_bytes << " bytes out, "
+            << report.seconds << " s, "
+            << (report.seconds > 0 ? megabytes / report.seconds : 0.0)
+            << " MB/s" << std::endl;
+
+  return 0;
+
+}
+
+/**
+ * @brief Serialize stdin to stdout
+ * @param serializer Serializer of the selected format
+ * @param format Selected format. The columnar batch is binary and is
+ *        written without the trailing new line of the text formats
+ * @return Exit code
+ */
+static int RunSerialize (const WAZUH::IWazuhSerializer& serializer, Format format) {
+
+  std::string serialized = serializer.Serialize (std::cin);
+
+  std::cout << serialized;
+
+  if (Format::kColumnar != format) { std::cout << std::endl; }
+
+  return 0;
+
+}
+
+/**
+ * @brief Deserialize stdin to stdout
+ * @param arg_parser Parsed command line
+ * @param serializer Serializer of the selected format
+ * @param delimited_serializer Delimited serializer, used with the delimited format
+ * @param format Selected format
+ * @return Exit code
+ */
+static int RunDeserialize (const WAZUH::ArgParser& arg_parser,
+                           const WAZUH::IWazuhSerializer& serializer,
+                           const WAZUH::DelimitedSerializer& delimited_serializer,
+                           Format format) {
+
+  if (Format::kDelimited == format) {
+
+    // Fields go straight from the input buffer to stdout
+    WAZUH::ScatterWriter output (STDOUT_FILENO);
+
+    std::cout.flush ();
+    delimited_serializer.DeserializeTo (std::cin, output);
+
+  } else if (!arg_parser[kColumnKey].empty ()) {
+
+    size_t index = arg_parser.GetInteger (kColumnKey, 0);
+
+    const auto& columnar = static_cast<const WAZUH::ColumnarSerializer&> (serializer);
+
+    std::cout << columnar.DeserializeColumn (std::cin, index);
+
+  } else {
+
+    std::string deserialized = serializer.Deserialize (std::cin);
+
+    std::cout << deserialized;
+
+  }
+
+  return 0;
+
+}
+
+/**
+ * @brief Deserialize the records of stdin matching '--filter' to stdout
+ * @param arg_parser Parsed command line
+ * @param delimited_serializer Serializer of the records
+ * @return Exit code
+ */
+static int RunFilteredDeserialize (const WAZUH::ArgParser& arg_parser,
+                                   const WAZUH::DelimitedSerializer& delimited_serializer) {
+
+  WAZUH::RecordFilter filter (delimited_serializer);
+  WAZUH::ScatterWriter output (STDOUT_FILENO);
+
+  filter.AddPredicates (std::string (arg_parser[kFilterKey]));
+
+  std::cout.flush ();
+  delimited_serializer.DeserializeMatching (std::cin, filter, output);
+
+  return 0;
+
+}
 
-  WAZUH::ArgParser arg_parser (kAppName, kAppDescription);
+/**
+ * @brief Transcode the records of stdin to JSON lines on stdout
+ * @param arg_parser Parsed command line
+ * @param delimited_serializer Serializer of the records
+ * @return Exit code
+ */
+static int RunTranscodeJson (const WAZUH::ArgParser& arg_parser,
+                             const WAZUH::DelimitedSerializer& delimited_serializer) {
+
+  WAZUH::JsonTranscoder transcoder (delimited_serializer);
+
+  transcoder.SetColumns (std::string (arg_parser[kColumnsKey]));
+  transcoder.Transcode (std::cin, std::cout);
+
+  return 0;
+
+}
+
+/**
+ * @brief Bench every operation over the corpus on stdin and print a table
+ * @param arg_parser Parsed command line
+ * @param delimited_serializer Serializer of the corpus
+ * @return Exit code, 1 if the track build saw a steady state allocation
+ */
+static int RunBench (const WAZUH::ArgParser& arg_parser,
+                     const WAZUH::DelimitedSerializer& delimited_serializer) {
+
+  size_t iterations = arg_parser.GetInteger (kIterationsKey,
+                                             WAZUH::kDefaultBenchIterations,
+                                             1);
+
+  WAZUH::Benchmark benchmark (delimited_serializer, iterations);
+  std::vector<WAZUH::BenchResult> results =
+    benchmark.Run (WAZUH::Benchmark::LoadRecords (std::cin));
+  bool steady_allocations = false;
+
+  std::cout << std::left << std::setw (22) << "Operation" << std::right
+            << std::setw (14) << "Records/s"
+            << std::setw (10) << "MB/s"
+            << std::setw (13) << "Allocs/rec"
+            << std::setw (12) << "Bytes/rec"
+            << std::setw (14) << "Peak live" << std::endl;
+
+  for (const WAZUH::BenchResult& result : results) {
+
+    double records = static_cast<double> (result.records);
+
+    std::cout << std::left << std::setw (22) << result.operation
+              << std::right << std::fixed << std::setprecision (0)
+              << std::setw (14) << records / result.seconds
+              << std::setprecision (1)
+              << std::setw (10) << result.bytes / kMegabyte / result.seconds
+              << std::setprecision (2)
+              << std::setw (13) << result.allocations / records
+              << std::setprecision (1)
+              << std::setw (12) << result.allocated_bytes / records
+              << std::setw (14) << result.peak_live_bytes << std::endl;
+
+    if (result.steady_state && 0 != result.allocations) {
+
+      std::cerr << "Steady state operation '" << result.operation
+                << "' allocated " << result.allocations << " times."
+                << std::endl;
+      steady_allocations = true;
+
+    }
+
+  }
 
-  arg_parser.AddOption (kHelpOption, "h",
-                        WAZUH::ArgRequirement::kOptional,
-                        kHelpDescription);
+  if (!WAZUH::AllocationTrackingEnabled ()) {
 
-  arg_parser.AddOption (kModeOption, "m",
-                        WAZUH::ArgRequirement::kMandatory,
-                        kModeDescription);
+    std::cout << "Allocations are only counted in the 'track' build." << std::endl;
 
-  arg_parser.AddOption (kDelimiterOption, "d",
-                        WAZUH::ArgRequirement::kOptional,
-                        kDelimiterDescription,
-                        ",");
+  } else if (steady_allocations) {
+
+    return 1;
+
+  }
+
+  return 0;
+
+}
+
+/**
+ * @brief Serialize the records pushed to the '--ring' ring until SIGINT or SIGTERM
+ * @param arg_parser Parsed command line
+ * @param delimited_serializer Serializer of the records
+ * @return Exit code
+ */
+static int RunRingServe (const WAZUH::ArgParser& arg_parser,
+                         const WAZUH::DelimitedSerializer& delimited_serializer) {
+
+  std::string ring (arg_parser[kRingKey]);
+  WAZUH::ShmRing shm_ring (ring, WAZUH::kDefaultRingSlots, WAZUH::kDefaultRingSlotSize);
+  WAZUH::RingServer server (delimited_serializer, shm_ring, STDOUT_FILENO);
+
+  struct sigaction action {};
+  action.sa_handler = RequestStop;
+  sigaction (SIGINT, &action, nullptr);
+  sigaction (SIGTERM, &action, nullptr);
+
+  std::cout.flush ();
+  WAZUH::RingReport report = server.Run (g_stop_requested);
+
+  std::cerr << "Ring: " << report.records << " records, "
+            << report.rejected << " rejected, "
+            << report.batches << " batches, "
+            << report.output_bytes << " bytes out, "
+            << report.seconds << " s" << std::endl;
+
+  return 0;
+
+}
+
+/**
+ * @brief Push stdin as one record to the '--ring' ring
+ * @param arg_parser Parsed command line
+ * @return Exit code
+ */
+static int RunRingPush (const WAZUH::ArgParser& arg_parser) {
+
+  // Same input as the serialize mode, every line is a field. Several
+  // threads pushing it repeatedly stress the lock free reservation
+  std::string text ((std::istreambuf_iterator<char> (std::cin)),
+                    std::istreambuf_iterator<char> ());
+  WAZUH::ShmRing shm_ring ((std::string (arg_parser[kRingKey])));
+  size_t threads = arg_parser.GetInteger (kThreadsKey, 1, 1);
+  size_t repeat = arg_parser.GetInteger (kIterationsKey, 1, 1);
+  std::vector<std::thread> producers;
+  std::vector<std::exception_ptr> errors (threads);
+
+  for (size_t i = 0; i < threads; ++i) {
+
+    producers.emplace_back ([&shm_ring, &text, &errors, repeat, i] {
+      try {
+        for (size_t n = 0; n < repeat; ++n) { shm_ring.Push (text); }
+      } catch (...) {
+        errors[i] = std::current_exception ();
+      }
+    });
+
+  }
+
+  for (std::thread& producer : producers) { producer.join (); }
+
+  for (const std::exception_ptr& error : errors) {
+
+    if (error) { std::rethrow_exception (error); }
+
+  }
+
+  return 0;
+
+}
+
+
+/******************************************************************************
+ * Implementation of public functions / methods
+ */
+
+/**
+ * @brief Main entry point of the application
+ */
+int main (int argc, char* argv[]) {
+
+  WAZUH::ArgParser arg_parser (kSchema);
 
   try {
 
     arg_parser.Parse (argc, argv);
 
-    std::string mode = arg_parser[kModeOption];
-    char delimiter = arg_parser[kDelimiterOption][0];
+    Mode mode = arg_parser.GetEnum (kModeKey, kModes);
+    Format format = arg_parser.GetEnum (kFormatKey, kFormats);
+    std::string delimiter = DecodeDelimiter (arg_parser[kDelimiterKey]);
 
     WAZUH::DelimitedSerializer delimited_serializer (delimiter);
 
-    if ("serialize" == mode) {
+    delimited_serializer.SetChecksum (arg_parser.GetEnum (kChecksumKey, kChecksums));
+    delimited_serializer.SetUtf8Policy (arg_parser.GetEnum (kUtf8Key, kUtf8Policies));
 
-      std::string serialized = delimited_serializer.Serialize (std::cin);
+    CheckOptions (arg_parser, mode, format, delimited_serializer);
 
-      std::cout << serialized << std::endl;
+    // Other formats are used through the serializer interface
+    std::unique_ptr<WAZUH::IWazuhSerializer> other_serializer;
 
-    } else if ("deserialize" == mode) {
+    if (Format::kDictionary == format) {
 
-      std::string deserialized = delimited_serializer.Deserialize (std::cin);
+      other_serializer = std::make_unique<WAZUH::DictionarySerializer> (delimiter);
 
-      std::cout << deserialized;
+    } else if (Format::kColumnar == format) {
 
-    } else {
+      other_serializer = std::make_unique<WAZUH::ColumnarSerializer> (delimiter);
+
+    }
+
+    const WAZUH::IWazuhSerializer& serializer =
+      other_serializer ? *other_serializer : delimited_serializer;
+
+    // The other modes reject '--batch' in CheckOptions
+    if (!arg_parser[kBatchKey].empty ()) {
+
+      return RunBatch (arg_parser, mode, delimited_serializer);
+
+    }
+
+    switch (mode) {
+
+      case Mode::kSerialize:
+
+        return RunSerialize (serializer, format);
+
+      case Mode::kDeserialize:
+
+        if (!arg_parser[kFilterKey].empty ()) {
+
+          return RunFilteredDeserialize (arg_parser, delimited_serializer);
 
-      std::cerr << "Invalid mode. Use 'serialize' or 'deserialize'." << std::endl;
-      return 1;
+        }
+
+        return RunDeserialize (arg_parser, serializer, delimited_serializer, format);
+
+      case Mode::kTranscodeJson:
+
+        return RunTranscodeJson (arg_parser, delimited_serializer);
+
+      case Mode::kBench:
+
+        return RunBench (arg_parser, delimited_serializer);
+
+      case Mode::kRingServe:
+
+        return RunRingServe (arg_parser, delimited_serializer);
+
+      case Mode::kRingPush:
+
+        return RunRingPush (arg_parser);
 
     }
 
@@ -110,6 +686,31 @@ int main (int argc, char* argv[]) {
     std::cerr << e.what() << std::endl;
     return 1;
 
+  } catch (const WAZUH::serializer_error& e) {
+
+    std::cerr << e.what() << std::endl;
+    return 1;
+
+  } catch (const WAZUH::filter_error& e) {
+
+    std::cerr << e.what() << std::endl;
+    return 1;
+
+  } catch (const WAZUH::transport_error& e) {
+
+    std::cerr << e.what() << std::endl;
+    return 1;
+
+  } catch (const WAZUH::batch_error& e) {
+
+    std::cerr << e.what() << std::endl;
+    return 1;
+
+  } catch (const std::system_error& e) {
+
+    std::cerr << e.what() << std::endl;
+    return 1;
+
   }
 
   return 0;